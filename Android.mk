@@ -35,6 +35,7 @@ SPVTOOLS_SRC_FILES := \
 		source/val/construct.cpp \
 		source/val/function.cpp \
 		source/val/instruction.cpp \
+		source/val/validation_cache.cpp \
 		source/val/validation_state.cpp \
 		source/val/validate.cpp \
 		source/val/validate_adjacency.cpp \
@@ -24,6 +24,12 @@ COMMON_COPTS = [
     ],
 })
 
+# The validator runs batch and threaded validation on std::thread.
+COMMON_LINKOPTS = select({
+    "@platforms//os:windows": [],
+    "//conditions:default": ["-lpthread"],
+})
+
 TEST_COPTS = COMMON_COPTS + [
 ] + select({
     "@platforms//os:windows": [
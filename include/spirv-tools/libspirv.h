@@ -717,6 +717,70 @@ SPIRV_TOOLS_EXPORT void spvValidatorOptionsSetAllowLocalSizeId(
 SPIRV_TOOLS_EXPORT void spvValidatorOptionsSetFriendlyNames(
     spv_validator_options options, bool val);
 
+// Records whether the validator should only perform the structural checks,
+// for modules from a trusted producer.  A module accepted in this mode has:
+//  - a valid header, and an id bound within the limits;
+//  - well-formed instructions whose operands match the grammar, and whose
+//    opcodes and operands are enabled by the declared capabilities,
+//    extensions and SPIR-V version;
+//  - the logical module layout, with every id defined exactly once, and
+//    forward references only where they are allowed;
+//  - well-formed type declarations, functions, function calls, entry points
+//    and execution modes;
+//  - a well-formed control flow graph: valid branch targets and OpPhi
+//    instructions, blocks ordered after their dominators, structured
+//    control flow rules where they apply, and definitions that dominate
+//    their uses.
+// The semantic checks of the remaining instructions are skipped.  This
+// includes memory, image, arithmetic and other per-opcode checks, extended
+// instructions, decoration and block layout rules, built-in variables,
+// interface matching and locations, and execution model limitations.
+SPIRV_TOOLS_EXPORT void spvValidatorOptionsSetStructuralOnly(
+    spv_validator_options options, bool val);
+
+// Records how many threads the validator may use for the checks it can run
+// on functions independently, such as the control flow checks.  If
+// |num_threads| is 0, one thread per hardware thread is used.  The default
+// is 1, which validates on the calling thread only.  Diagnostics are
+// reported in the same order as with a single thread.
+SPIRV_TOOLS_EXPORT void spvValidatorOptionsSetNumThreads(
+    spv_validator_options options, uint32_t num_threads);
+
+// Records the directory of a persistent validation cache.  When set,
+// spvValidateWithOptions and spvValidateBinaries look up the outcome of
+// validating the same binary for the same target environment, with the same
+// options and the same version of the tools, and if found return the cached
+// status and report the cached diagnostics without validating again.
+// Otherwise the outcome is stored in the directory for next time.  The
+// directory must already exist.  Passing null or an empty string disables the
+// cache, which is the default.  Failures to read or write the cache are not
+// reported; the module is simply validated.
+//
+// Each entry holds the whole binary it applies to, and is only reused for an
+// identical binary.  The cache holds at most 1024 entries, older entries
+// being replaced by newer ones, and modules over 4 MiB are not cached.
+// A release is identified by its version and the version of the SPIR-V
+// headers it was built with.  Development versions are shared by every
+// build between two releases, so they only use the cache when a cache salt
+// identifying the build is set with spvValidatorOptionsSetCacheSalt.
+//
+// The cache directory is trusted: the outcomes found there are reported as
+// they are.  Anyone who can write to it can change the outcome reported for
+// any module, including making an invalid module pass validation.  Use a
+// directory that only the users running the validator can write to.
+SPIRV_TOOLS_EXPORT void spvValidatorOptionsSetCacheDirectory(
+    spv_validator_options options, const char* directory);
+
+// Records a string that is added to the key of every validation cache entry.
+// Entries are only reused by validations with the same salt.  Set it to
+// something that changes whenever the tools are rebuilt from different
+// sources, grammar tables or SPIR-V headers, such as a hash of the library
+// or a build id.  Release versions are identified by their version already,
+// but development versions only use the cache when a salt is set.  Passing
+// null or an empty string clears the salt, which is the default.
+SPIRV_TOOLS_EXPORT void spvValidatorOptionsSetCacheSalt(
+    spv_validator_options options, const char* salt);
+
 // Creates an optimizer options object with default options. Returns a valid
 // options object. The object remains valid until it is passed into
 // |spvOptimizerOptionsDestroy|.
@@ -889,6 +953,26 @@ SPIRV_TOOLS_EXPORT spv_result_t
 spvValidateBinary(const spv_const_context context, const uint32_t* words,
                   const size_t num_words, spv_diagnostic* diagnostic);
 
+// Validates |num_binaries| SPIR-V binaries for correctness, all with the
+// same validator |options|, spreading the modules over up to |num_threads|
+// worker threads.  If |num_threads| is 0, one worker per hardware thread is
+// used.  The grammar tables of |context| are shared by all workers.
+//
+// |results| must point to |num_binaries| entries; entry i receives the
+// status of binaries[i].  If |diagnostics| is non-null, it must also point to
+// |num_binaries| entries; entry i receives the diagnostic for binaries[i], or
+// null if there is none.  Otherwise every message is sent to the context's
+// message consumer with its original level once all binaries are validated.
+// The messages are sent in input order, from the calling thread, and each is
+// prefixed with "module <i>: ", where i is the index of its binary.
+//
+// Returns SPV_SUCCESS if every binary is valid.  Otherwise returns the first
+// failing status in input order.
+SPIRV_TOOLS_EXPORT spv_result_t spvValidateBinaries(
+    const spv_const_context context, const spv_const_validator_options options,
+    const spv_const_binary_t* binaries, size_t num_binaries,
+    uint32_t num_threads, spv_result_t* results, spv_diagnostic* diagnostics);
+
 // Creates a diagnostic object. The position parameter specifies the location in
 // the text/binary stream. The message parameter, copied into the diagnostic
 // object, contains the error message to display.
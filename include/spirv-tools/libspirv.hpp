@@ -17,6 +17,7 @@
 
 #include <functional>
 #include <memory>
+#include <ostream>
 #include <string>
 #include <vector>
 
@@ -158,6 +159,50 @@ class SPIRV_TOOLS_EXPORT ValidatorOptions {
     spvValidatorOptionsSetFriendlyNames(options_, val);
   }
 
+  // Records whether only the structural checks should be performed, skipping
+  // the semantic checks of individual instructions, decorations, built-ins
+  // and interfaces.  See spvValidatorOptionsSetStructuralOnly for the exact
+  // set of guarantees.
+  void SetStructuralOnly(bool val) {
+    spvValidatorOptionsSetStructuralOnly(options_, val);
+  }
+
+  // Sets how many threads may be used for the checks that run on each
+  // function independently. 0 means one per hardware thread. Defaults to 1.
+  void SetNumThreads(uint32_t num_threads) {
+    spvValidatorOptionsSetNumThreads(options_, num_threads);
+  }
+
+  // Sets the directory of a persistent cache of validation outcomes, or
+  // disables the cache if |directory| is empty.  See
+  // spvValidatorOptionsSetCacheDirectory for details.
+  void SetCacheDirectory(const std::string& directory) {
+    spvValidatorOptionsSetCacheDirectory(options_, directory.c_str());
+  }
+
+  // Sets the string that identifies this build of the tools in the keys of
+  // the validation cache.  See spvValidatorOptionsSetCacheSalt for details.
+  void SetCacheSalt(const std::string& salt) {
+    spvValidatorOptionsSetCacheSalt(options_, salt.c_str());
+  }
+
+  // Sets the stream to which validation prints the time used by each of its
+  // stages, and the number of instructions each stage processed.  If |out| is
+  // null, no report is printed, which is the default.  Requesting a report
+  // bypasses the validation cache.
+  //
+  // CPU time is that of the validating thread, so that modules validated
+  // concurrently do not count towards each other's reports; work done on
+  // worker threads only shows in wall time.  Each module's report is written
+  // to |out| in one piece, under a lock, so spvValidateBinaries can share the
+  // stream between its workers.  The stream must not be written by anything
+  // else while modules are being validated.
+  //
+  // Reports are only available where the tools were built with timers
+  // enabled, which is on Unix-like systems only.  Returns false, and leaves
+  // reports disabled, if |out| is not null and reports are not available.
+  bool SetTimeReport(std::ostream* out);
+
  private:
   spv_validator_options options_;
 };
@@ -383,6 +428,17 @@ class SPIRV_TOOLS_EXPORT SpirvTools {
   // binary itself, or in the validator options.
   bool Validate(const uint32_t* binary, size_t binary_size,
                 spv_validator_options options) const;
+  // Validates each of the given |binaries| with the same |options|, spreading
+  // the modules over up to |num_threads| worker threads (0 means one per
+  // hardware thread).  Returns true if all of them are valid.  If |results| is
+  // non-null, it receives the status of each binary, in input order.  Issues
+  // are communicated via the message consumer registered, in input order, and
+  // each message is prefixed with "module <i>: ", where i is the index of the
+  // binary it is about.
+  bool Validate(const std::vector<std::vector<uint32_t>>& binaries,
+                spv_validator_options options,
+                std::vector<spv_result_t>* results,
+                uint32_t num_threads = 0) const;
 
   // Was this object successfully constructed.
   bool IsValid() const;
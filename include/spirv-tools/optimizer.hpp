@@ -32,6 +32,37 @@ class Pass;
 struct DescriptorSetAndBinding;
 }  // namespace opt
 
+// An in-memory SPIR-V module that can be optimized by several optimizers in
+// turn. The module is parsed once by Optimizer::Load() and serialized once by
+// ToBinary(), instead of once per call to Optimizer::Run() on a binary.
+//
+// Instances can only be moved. Copying is disabled.
+class SPIRV_TOOLS_EXPORT OptimizerModule {
+ public:
+  // Constructs an empty module. Use Optimizer::Load() to fill it.
+  OptimizerModule();
+
+  OptimizerModule(const OptimizerModule&) = delete;
+  OptimizerModule(OptimizerModule&&);
+  OptimizerModule& operator=(const OptimizerModule&) = delete;
+  OptimizerModule& operator=(OptimizerModule&&);
+
+  ~OptimizerModule();
+
+  // Returns true if a module has been loaded.
+  bool IsLoaded() const;
+
+  // Writes the module as a binary into |binary|, replacing its contents.
+  // Returns false if no module has been loaded.
+  bool ToBinary(std::vector<uint32_t>* binary) const;
+
+ private:
+  friend class Optimizer;
+
+  struct SPIRV_TOOLS_LOCAL Impl;  // Opaque struct for holding internal data.
+  std::unique_ptr<Impl> impl_;    // Unique pointer to internal data.
+};
+
 // C++ interface for SPIR-V optimization functionalities. It wraps the context
 // (including target environment and the corresponding SPIR-V grammar) and
 // provides methods for registering optimization passes and optimizing.
@@ -220,6 +251,37 @@ class SPIRV_TOOLS_EXPORT Optimizer {
            std::vector<uint32_t>* optimized_binary,
            const spv_optimizer_options opt_options) const;
 
+  // Parses the SPIR-V module |binary| into |module|, replacing its previous
+  // contents, so that it can be optimized by successive calls to Run() on
+  // |module|. The binary is validated first if |opt_options| asks for it, in
+  // the same way as in Run() on a binary.
+  //
+  // Returns false if |binary| fails to validate or to parse. In that case
+  // |module| is left empty.
+  bool Load(const uint32_t* binary, const size_t binary_size,
+            OptimizerModule* module) const;
+  bool Load(const uint32_t* binary, const size_t binary_size,
+            OptimizerModule* module,
+            const spv_optimizer_options opt_options) const;
+
+  // Optimizes |module| in place with the registered passes. The module is
+  // neither validated before the passes run nor serialized after they finish,
+  // so a module can go through several optimizers and be written out once
+  // with OptimizerModule::ToBinary(). The validator options in |opt_options|
+  // are still used by passes that validate after each transform.
+  //
+  // |module| may have been loaded by another optimizer, as long as that
+  // optimizer has the same target environment as this one. Messages emitted
+  // while this call runs go to this optimizer's message consumer.
+  //
+  // Returns false if |module| has not been loaded, if it was loaded for a
+  // different target environment, or if errors occur in any of the registered
+  // passes. In that case, no further passes are executed and
+  // the contents of |module| may be invalid.
+  bool Run(OptimizerModule* module) const;
+  bool Run(OptimizerModule* module,
+           const spv_optimizer_options opt_options) const;
+
   // Returns a vector of strings with all the pass names added to this
   // optimizer's pass manager. These strings are valid until the associated
   // pass manager is destroyed.
@@ -33,6 +33,7 @@
 #include "source/operand.h"
 #include "source/spirv_constant.h"
 #include "source/spirv_endian.h"
+#include "source/util/dense_id_map.h"
 #include "source/util/string_utils.h"
 
 spv_result_t spvBinaryHeaderGet(const spv_const_binary binary,
@@ -222,7 +223,7 @@ class Parser {
     // Maps a result ID to its type ID.  By convention:
     //  - a result ID that is a type definition maps to itself.
     //  - a result ID without a type maps to 0.  (E.g. for OpLabel)
-    std::unordered_map<uint32_t, uint32_t> id_to_type_id;
+    spvtools::utils::DenseIdMap<uint32_t> id_to_type_id;
     // Maps a type ID to its number type description.
     std::unordered_map<uint32_t, NumberType> type_id_to_number_type_info;
     // Maps an ExtInstImport id to the extended instruction type.
@@ -279,6 +280,11 @@ spv_result_t Parser::parseModule() {
     }
   }
 
+  // Size the id map up front so it does not grow while parsing.  The bound
+  // comes from the input, so never reserve more than one entry per word.
+  _.id_to_type_id.reserve(
+      static_cast<uint32_t>(std::min<size_t>(header.bound, _.num_words)));
+
   // Process the instructions.
   _.word_index = SPV_INDEX_INSTRUCTION;
   while (_.word_index < _.num_words)
@@ -595,18 +601,20 @@ spv_result_t Parser::parseOperand(size_t inst_offset,
 
     case SPV_OPERAND_TYPE_LITERAL_STRING:
     case SPV_OPERAND_TYPE_OPTIONAL_LITERAL_STRING: {
+      // Only measure the string here: callers get a view of its words, so
+      // there is no need to decode it into a std::string.
       const size_t max_words = _.num_words - _.word_index;
-      std::string string =
-          spvtools::utils::MakeString(_.words + _.word_index, max_words, false);
+      const size_t string_length = spvtools::utils::EncodedStringLength(
+          _.words + _.word_index, max_words);
 
-      if (string.length() == max_words * 4)
+      if (string_length == max_words * 4)
         return exhaustedInputDiagnostic(inst_offset, opcode, type);
 
       // Make sure we can record the word count without overflow.
       //
       // This error can't currently be triggered because of validity
       // checks elsewhere.
-      const size_t string_num_words = string.length() / 4 + 1;
+      const size_t string_num_words = string_length / 4 + 1;
       if (string_num_words > std::numeric_limits<uint16_t>::max()) {
         return diagnostic() << "Literal string is longer than "
                             << std::numeric_limits<uint16_t>::max()
@@ -619,6 +627,8 @@ spv_result_t Parser::parseOperand(size_t inst_offset,
         // Record the extended instruction type for the ID for this import.
         // There is only one string literal argument to OpExtInstImport,
         // so it's sufficient to guard this just on the opcode.
+        const std::string string = spvtools::utils::MakeString(
+            _.words + _.word_index, string_num_words);
         const spv_ext_inst_type_t ext_inst_type =
             spvExtInstImportTypeGet(string.c_str());
         if (SPV_EXT_INST_TYPE_NONE == ext_inst_type) {
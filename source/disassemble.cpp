@@ -24,6 +24,8 @@
 #include <cstring>
 #include <iomanip>
 #include <memory>
+#include <sstream>
+#include <string>
 #include <unordered_map>
 #include <utility>
 
@@ -530,6 +532,23 @@ std::string spvInstructionBinaryToText(const spv_target_env env,
 
   return output;
 }
+
+std::string spvInstructionBinaryToText(const AssemblyGrammar& grammar,
+                                       const spv_parsed_instruction_t& inst,
+                                       const NameMapper& name_mapper,
+                                       uint32_t options) {
+  options &= ~(SPV_BINARY_TO_TEXT_OPTION_PRINT |
+               SPV_BINARY_TO_TEXT_OPTION_SHOW_BYTE_OFFSET);
+  std::stringstream stream;
+  disassemble::InstructionDisassembler disassembler(grammar, stream, options,
+                                                    name_mapper);
+  disassembler.EmitInstruction(inst, 0);
+
+  std::string output = stream.str();
+  // Drop trailing newline characters.
+  while (!output.empty() && output.back() == '\n') output.pop_back();
+  return output;
+}
 }  // namespace spvtools
 
 spv_result_t spvBinaryToText(const spv_const_context context,
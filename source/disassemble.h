@@ -37,6 +37,17 @@ std::string spvInstructionBinaryToText(const spv_target_env env,
                                        const uint32_t options);
 
 class AssemblyGrammar;
+
+// Decodes the given parsed SPIR-V instruction to its assembly text, naming ids
+// with |name_mapper|. Unlike the overload above, this does not need to parse
+// the module again. The options parameter is a bit field of
+// spv_binary_to_text_options_t; SPV_BINARY_TO_TEXT_OPTION_PRINT and
+// SPV_BINARY_TO_TEXT_OPTION_SHOW_BYTE_OFFSET are ignored.
+std::string spvInstructionBinaryToText(const AssemblyGrammar& grammar,
+                                       const spv_parsed_instruction_t& inst,
+                                       const NameMapper& name_mapper,
+                                       uint32_t options);
+
 namespace disassemble {
 
 // Shared code with other tools (than the disassembler) that might need to
@@ -20,6 +20,7 @@
 #include <utility>
 #include <vector>
 
+#include "source/spirv_validator_options.h"
 #include "source/table.h"
 
 namespace spvtools {
@@ -48,6 +49,16 @@ spv_context& Context::CContext() { return context_; }
 
 const spv_context& Context::CContext() const { return context_; }
 
+bool ValidatorOptions::SetTimeReport(std::ostream* out) {
+#if defined(SPIRV_TIMER_ENABLED)
+  options_->time_report_stream = out;
+  return true;
+#else
+  options_->time_report_stream = nullptr;
+  return out == nullptr;
+#endif
+}
+
 // Structs for holding the data members for SpvTools.
 struct SpirvTools::Impl {
   explicit Impl(spv_target_env env) : context(spvContextCreate(env)) {
@@ -166,6 +177,24 @@ bool SpirvTools::Validate(const uint32_t* binary, const size_t binary_size,
   return valid;
 }
 
+bool SpirvTools::Validate(const std::vector<std::vector<uint32_t>>& binaries,
+                          spv_validator_options options,
+                          std::vector<spv_result_t>* results,
+                          uint32_t num_threads) const {
+  std::vector<spv_const_binary_t> the_binaries;
+  the_binaries.reserve(binaries.size());
+  for (const auto& binary : binaries) {
+    the_binaries.push_back({binary.data(), binary.size()});
+  }
+  std::vector<spv_result_t> statuses(binaries.size(), SPV_SUCCESS);
+  bool valid =
+      spvValidateBinaries(impl_->context, options, the_binaries.data(),
+                          the_binaries.size(), num_threads, statuses.data(),
+                          nullptr) == SPV_SUCCESS;
+  if (results) *results = std::move(statuses);
+  return valid;
+}
+
 bool SpirvTools::IsValid() const { return impl_->context != nullptr; }
 
 }  // namespace spvtools
@@ -20,6 +20,7 @@
 #include <string.h>
 
 #include <algorithm>
+#include <string_view>
 
 #include "DebugInfo.h"
 #include "OpenCLDebugInfo100.h"
@@ -56,19 +57,21 @@ spv_result_t spvOperandTableNameLookup(spv_target_env,
   if (!table) return SPV_ERROR_INVALID_TABLE;
   if (!name || !pEntry) return SPV_ERROR_INVALID_POINTER;
 
+  const std::string_view needle(name, nameLength);
   for (uint64_t typeIndex = 0; typeIndex < table->count; ++typeIndex) {
     const auto& group = table->types[typeIndex];
     if (type != group.type) continue;
-    for (uint64_t index = 0; index < group.count; ++index) {
-      const auto& entry = group.entries[index];
-      // We consider the current operand as available as long as
-      // it is in the grammar.  It might not be *valid* to use,
-      // but that should be checked by the validator, not by parsing.
-      if (nameLength == strlen(entry.name) &&
-          !strncmp(entry.name, name, nameLength)) {
-        *pEntry = &entry;
-        return SPV_SUCCESS;
-      }
+    const auto name_less = [&group](uint16_t index, std::string_view n) {
+      return std::string_view(group.entries[index].name) < n;
+    };
+    const uint16_t* const index_end = group.nameIndex + group.count;
+    auto it = std::lower_bound(group.nameIndex, index_end, needle, name_less);
+    // We consider the current operand as available as long as
+    // it is in the grammar.  It might not be *valid* to use,
+    // but that should be checked by the validator, not by parsing.
+    if (it != index_end && needle == group.entries[*it].name) {
+      *pEntry = &group.entries[*it];
+      return SPV_SUCCESS;
     }
   }
 
@@ -37,7 +37,6 @@ class AmdExtensionToKhrPass : public Pass {
            IRContext::kAnalysisLoopAnalysis | IRContext::kAnalysisNameMap |
            IRContext::kAnalysisScalarEvolution |
            IRContext::kAnalysisRegisterPressure |
-           IRContext::kAnalysisValueNumberTable |
            IRContext::kAnalysisStructuredCFG |
            IRContext::kAnalysisBuiltinVarId |
            IRContext::kAnalysisIdToFuncMapping | IRContext::kAnalysisTypes |
@@ -187,6 +187,13 @@ void MergeWithSuccessor(IRContext* context, Function* func,
     context->InvalidateAnalyses(IRContext::Analysis::kAnalysisStructuredCFG);
   }
 
+  // Keep the CFG in sync: the edges leaving sbi now leave bi, and the edge
+  // from bi to sbi goes away with sbi.
+  const bool update_cfg = context->AreAnalysesValid(IRContext::kAnalysisCFG);
+  if (update_cfg) {
+    context->cfg()->ForgetBlock(&*sbi);
+  }
+
   // Update the inst-to-block mapping for the instructions in sbi.
   for (auto& inst : *sbi) {
     context->set_instr_block(&inst, &*bi);
@@ -196,6 +203,9 @@ void MergeWithSuccessor(IRContext* context, Function* func,
 
   // Now actually move the instructions.
   bi->AddInstructions(&*sbi);
+  if (update_cfg) {
+    context->cfg()->AddEdges(&*bi);
+  }
 
   if (merge_inst) {
     if (pred_is_header && lab_id == merge_inst->GetSingleWordInOperand(0u)) {
@@ -223,6 +233,7 @@ void MergeWithSuccessor(IRContext* context, Function* func,
       merge_inst->InsertBefore(terminator);
     }
   }
+  context->UpdateDominatorsForMergedBlocks(&*bi, &*sbi);
   context->ReplaceAllUsesWith(lab_id, bi->id());
   context->KillInst(sbi->GetLabelInst());
   (void)sbi.Erase();
@@ -56,6 +56,17 @@ void CFG::AddEdges(BasicBlock* blk) {
       [blk_id, this](const uint32_t succ_id) { AddEdge(blk_id, succ_id); });
 }
 
+void CFG::ReanalyzeFunction(Function* func) {
+  // All the predecessors of a block are in the same function, so clearing
+  // the lists of the blocks of |func| drops every stale edge.
+  for (auto& blk : *func) {
+    label2preds_[blk.id()].clear();
+  }
+  for (auto& blk : *func) {
+    RegisterBlock(&blk);
+  }
+}
+
 void CFG::RemoveNonExistingEdges(uint32_t blk_id) {
   std::vector<uint32_t> updated_pred_list;
   for (uint32_t id : preds(blk_id)) {
@@ -130,6 +130,12 @@ class CFG {
   // the basic block id |blk_id|.
   void RemoveNonExistingEdges(uint32_t blk_id);
 
+  // Recomputes the blocks and predecessors of |func| from its current blocks
+  // and their terminators, leaving the other functions as they are. Entries
+  // for blocks that were removed from |func| without being forgotten are left
+  // in place, but no block of the module refers to them anymore.
+  void ReanalyzeFunction(Function* func);
+
   // Remove all edges that leave |bb|.
   void RemoveSuccessorEdges(const BasicBlock* bb) {
     bb->ForEachSuccessorLabel(
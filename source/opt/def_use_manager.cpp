@@ -14,9 +14,18 @@
 
 #include "source/opt/def_use_manager.h"
 
+#include <algorithm>
+
 namespace spvtools {
 namespace opt {
 namespace analysis {
+namespace {
+
+bool UserLess(const Instruction* lhs, const Instruction* rhs) {
+  return lhs->unique_id() < rhs->unique_id();
+}
+
+}  // namespace
 
 void DefUseManager::AnalyzeInstDef(Instruction* inst) {
   const uint32_t def_id = inst->result_id();
@@ -54,7 +63,7 @@ void DefUseManager::AnalyzeInstUse(Instruction* inst) {
         uint32_t use_id = inst->GetSingleWordOperand(i);
         Instruction* def = GetDef(use_id);
         assert(def && "Definition is not registered.");
-        id_to_users_.insert(UserEntry{def, inst});
+        AddUser(def, inst);
         used_ids->push_back(use_id);
       } break;
       default:
@@ -94,21 +103,43 @@ const Instruction* DefUseManager::GetDef(uint32_t id) const {
   return iter->second;
 }
 
-DefUseManager::IdToUsersMap::const_iterator DefUseManager::UsersBegin(
-    const Instruction* def) const {
-  return id_to_users_.lower_bound(
-      UserEntry{const_cast<Instruction*>(def), nullptr});
+void DefUseManager::AddUser(const Instruction* def, Instruction* user) {
+  UserList& users = id_to_users_[def];
+  // Instructions are mostly analyzed in creation order, so new users usually
+  // go at the end.
+  if (users.empty() || UserLess(users.back(), user)) {
+    users.push_back(user);
+    return;
+  }
+  auto iter = std::lower_bound(users.begin(), users.end(), user, UserLess);
+  if (iter == users.end() || *iter != user) users.insert(iter, user);
+}
+
+void DefUseManager::RemoveUser(const Instruction* def,
+                               const Instruction* user) {
+  auto list_iter = id_to_users_.find(def);
+  if (list_iter == id_to_users_.end()) return;
+  UserList& users = list_iter->second;
+  auto iter = std::lower_bound(users.begin(), users.end(), user, UserLess);
+  if (iter != users.end() && *iter == user) users.erase(iter);
 }
 
-bool DefUseManager::UsersNotEnd(const IdToUsersMap::const_iterator& iter,
-                                const IdToUsersMap::const_iterator& cached_end,
-                                const Instruction* inst) const {
-  return (iter != cached_end && iter->def == inst);
+bool DefUseManager::HasUser(const Instruction* def,
+                            const Instruction* user) const {
+  auto list_iter = id_to_users_.find(def);
+  if (list_iter == id_to_users_.end()) return false;
+  const UserList& users = list_iter->second;
+  return std::binary_search(users.begin(), users.end(), user, UserLess);
 }
 
-bool DefUseManager::UsersNotEnd(const IdToUsersMap::const_iterator& iter,
-                                const Instruction* inst) const {
-  return UsersNotEnd(iter, id_to_users_.end(), inst);
+size_t DefUseManager::NextUserIndex(const UserList& users, size_t index,
+                                    const Instruction* user,
+                                    uint32_t unique_id) {
+  if (index < users.size() && users[index] == user) return index + 1;
+  auto iter = std::upper_bound(
+      users.begin(), users.end(), unique_id,
+      [](uint32_t id, const Instruction* u) { return id < u->unique_id(); });
+  return static_cast<size_t>(iter - users.begin());
 }
 
 bool DefUseManager::WhileEachUser(
@@ -118,9 +149,14 @@ bool DefUseManager::WhileEachUser(
          "Definition is not registered.");
   if (!def->HasResultId()) return true;
 
-  auto end = id_to_users_.end();
-  for (auto iter = UsersBegin(def); UsersNotEnd(iter, end, def); ++iter) {
-    if (!f(iter->user)) return false;
+  auto list_iter = id_to_users_.find(def);
+  if (list_iter == id_to_users_.end()) return true;
+  const UserList& users = list_iter->second;
+  for (size_t i = 0; i < users.size();) {
+    Instruction* user = users[i];
+    const uint32_t unique_id = user->unique_id();
+    if (!f(user)) return false;
+    i = NextUserIndex(users, i, user, unique_id);
   }
   return true;
 }
@@ -151,9 +187,12 @@ bool DefUseManager::WhileEachUse(
          "Definition is not registered.");
   if (!def->HasResultId()) return true;
 
-  auto end = id_to_users_.end();
-  for (auto iter = UsersBegin(def); UsersNotEnd(iter, end, def); ++iter) {
-    Instruction* user = iter->user;
+  auto list_iter = id_to_users_.find(def);
+  if (list_iter == id_to_users_.end()) return true;
+  const UserList& users = list_iter->second;
+  for (size_t i = 0; i < users.size();) {
+    Instruction* user = users[i];
+    const uint32_t unique_id = user->unique_id();
     for (uint32_t idx = 0; idx != user->NumOperands(); ++idx) {
       const Operand& op = user->GetOperand(idx);
       if (op.type != SPV_OPERAND_TYPE_RESULT_ID && spvIsIdType(op.type)) {
@@ -162,6 +201,7 @@ bool DefUseManager::WhileEachUse(
         }
       }
     }
+    i = NextUserIndex(users, i, user, unique_id);
   }
   return true;
 }
@@ -235,12 +275,7 @@ void DefUseManager::ClearInst(Instruction* inst) {
     EraseUseRecordsOfOperandIds(inst);
     if (inst->result_id() != 0) {
       // Remove all uses of this inst.
-      auto users_begin = UsersBegin(inst);
-      auto end = id_to_users_.end();
-      auto new_end = users_begin;
-      for (; UsersNotEnd(new_end, end, inst); ++new_end) {
-      }
-      id_to_users_.erase(users_begin, new_end);
+      id_to_users_.erase(inst);
       id_to_def_.erase(inst->result_id());
     }
   }
@@ -252,8 +287,7 @@ void DefUseManager::EraseUseRecordsOfOperandIds(const Instruction* inst) {
   auto iter = inst_to_used_ids_.find(inst);
   if (iter != inst_to_used_ids_.end()) {
     for (auto use_id : iter->second) {
-      id_to_users_.erase(
-          UserEntry{GetDef(use_id), const_cast<Instruction*>(inst)});
+      RemoveUser(GetDef(use_id), inst);
     }
     inst_to_used_ids_.erase(iter);
   }
@@ -277,19 +311,24 @@ bool CompareAndPrintDifferences(const DefUseManager& lhs,
     same = false;
   }
 
-  if (lhs.id_to_users_ != rhs.id_to_users_) {
-    for (auto p : lhs.id_to_users_) {
-      if (rhs.id_to_users_.count(p) == 0) {
+  bool users_differ = false;
+  for (const auto& p : lhs.id_to_users_) {
+    for (const Instruction* user : p.second) {
+      if (!rhs.HasUser(p.first, user)) {
         printf("Diff in id_to_users: missing value in rhs\n");
+        users_differ = true;
       }
     }
-    for (auto p : rhs.id_to_users_) {
-      if (lhs.id_to_users_.count(p) == 0) {
+  }
+  for (const auto& p : rhs.id_to_users_) {
+    for (const Instruction* user : p.second) {
+      if (!lhs.HasUser(p.first, user)) {
         printf("Diff in id_to_users: missing value in lhs\n");
+        users_differ = true;
       }
     }
-    same = false;
   }
+  if (users_differ) same = false;
 
   if (lhs.inst_to_used_ids_ != rhs.inst_to_used_ids_) {
     for (auto p : lhs.inst_to_used_ids_) {
@@ -21,60 +21,17 @@
 
 #include "source/opt/instruction.h"
 #include "source/opt/module.h"
+#include "source/util/dense_id_map.h"
 #include "spirv-tools/libspirv.hpp"
 
 namespace spvtools {
 namespace opt {
 namespace analysis {
 
-// Definition should never be null. User can be null, however, such an entry
-// should be used only for searching (e.g. all users of a particular definition)
-// and never stored in a container.
-struct UserEntry {
-  Instruction* def;
-  Instruction* user;
-};
-
-inline bool operator==(const UserEntry& lhs, const UserEntry& rhs) {
-  return lhs.def == rhs.def && lhs.user == rhs.user;
-}
-
-// Orders UserEntry for use in associative containers (i.e. less than ordering).
-//
-// The definition of an UserEntry is treated as the major key and the users as
-// the minor key so that all the users of a particular definition are
-// consecutive in a container.
-//
-// A null user always compares less than a real user. This is done to provide
-// easy values to search for the beginning of the users of a particular
-// definition (i.e. using {def, nullptr}).
-struct UserEntryLess {
-  bool operator()(const UserEntry& lhs, const UserEntry& rhs) const {
-    // If lhs.def and rhs.def are both null, fall through to checking the
-    // second entries.
-    if (!lhs.def && rhs.def) return true;
-    if (lhs.def && !rhs.def) return false;
-
-    // If neither definition is null, then compare unique ids.
-    if (lhs.def && rhs.def) {
-      if (lhs.def->unique_id() < rhs.def->unique_id()) return true;
-      if (rhs.def->unique_id() < lhs.def->unique_id()) return false;
-    }
-
-    // Return false on equality.
-    if (!lhs.user && !rhs.user) return false;
-    if (!lhs.user) return true;
-    if (!rhs.user) return false;
-
-    // If neither user is null then compare unique ids.
-    return lhs.user->unique_id() < rhs.user->unique_id();
-  }
-};
-
 // A class for analyzing and managing defs and uses in an Module.
 class DefUseManager {
  public:
-  using IdToDefMap = std::unordered_map<uint32_t, Instruction*>;
+  using IdToDefMap = utils::DenseIdMap<Instruction*>;
 
   // Constructs a def-use manager from the given |module|. All internal messages
   // will be communicated to the outside via the given message |consumer|. This
@@ -193,25 +150,29 @@ class DefUseManager {
   void UpdateDefUse(Instruction* inst);
 
  private:
-  using IdToUsersMap = std::set<UserEntry, UserEntryLess>;
+  // The users of a definition, without duplicates, sorted by unique id.
+  using UserList = std::vector<Instruction*>;
+  // Maps each definition to its users. A definition may map to an empty list
+  // after its users have been cleared; that is the same as having no entry.
+  using IdToUsersMap = std::unordered_map<const Instruction*, UserList>;
   using InstToUsedIdsMap =
       std::unordered_map<const Instruction*, std::vector<uint32_t>>;
 
-  // Returns the first location that {|def|, nullptr} could be inserted into the
-  // users map without violating ordering.
-  IdToUsersMap::const_iterator UsersBegin(const Instruction* def) const;
+  // Records that |user| uses |def|.
+  void AddUser(const Instruction* def, Instruction* user);
 
-  // Returns true if |iter| has not reached the end of |def|'s users.
-  //
-  // In the first version |iter| is compared against the end of the map for
-  // validity before other checks. In the second version, |iter| is compared
-  // against |cached_end| for validity before other checks. This allows caching
-  // the map's end which is a performance improvement on some platforms.
-  bool UsersNotEnd(const IdToUsersMap::const_iterator& iter,
-                   const Instruction* def) const;
-  bool UsersNotEnd(const IdToUsersMap::const_iterator& iter,
-                   const IdToUsersMap::const_iterator& cached_end,
-                   const Instruction* def) const;
+  // Removes the record that |user| uses |def|, if there is one.
+  void RemoveUser(const Instruction* def, const Instruction* user);
+
+  // Returns true if |user| is recorded as a user of |def|.
+  bool HasUser(const Instruction* def, const Instruction* user) const;
+
+  // Returns the position in |users| of the user following the one with
+  // |unique_id| that was at position |index|. The list may have been modified
+  // since |index| was computed, e.g. by a callback that updated the def-use
+  // records; this finds the next user in unique id order regardless.
+  static size_t NextUserIndex(const UserList& users, size_t index,
+                              const Instruction* user, uint32_t unique_id);
 
   // Analyzes the defs and uses in the given |module| and populates data
   // structures in this class. Does nothing if |module| is nullptr.
@@ -359,6 +359,50 @@ void DominatorTree::ResetDFNumbering() {
   for (auto root : roots_) DepthFirstSearch(root, getSucc, preFunc, postFunc);
 }
 
+void DominatorTree::ReplaceInParent(DominatorTreeNode* node,
+                                    DominatorTreeNode* replacement) {
+  std::vector<DominatorTreeNode*>& siblings =
+      node->parent_ ? node->parent_->children_ : roots_;
+  std::replace(siblings.begin(), siblings.end(), node, replacement);
+  replacement->parent_ = node->parent_;
+}
+
+void DominatorTree::MergeBlocks(BasicBlock* bb, BasicBlock* successor) {
+  DominatorTreeNode* node = GetTreeNode(bb);
+  DominatorTreeNode* removed = GetTreeNode(successor);
+  if (!removed) {
+    return;
+  }
+  assert(node && (removed->parent_ == node || node->parent_ == removed) &&
+         "The blocks must be adjacent in the tree.");
+
+  if (removed->parent_ == node) {
+    // The children of |successor| move up to |bb|, in place of |successor|.
+    auto pos = std::find(node->children_.begin(), node->children_.end(),
+                         removed);
+    pos = node->children_.erase(pos);
+    for (DominatorTreeNode* child : removed->children_) {
+      child->parent_ = node;
+    }
+    node->children_.insert(pos, removed->children_.begin(),
+                           removed->children_.end());
+  } else {
+    // |bb| takes the place of |successor|, and adopts its other children.
+    removed->children_.erase(std::find(removed->children_.begin(),
+                                       removed->children_.end(), node));
+    ReplaceInParent(removed, node);
+    for (DominatorTreeNode* child : removed->children_) {
+      child->parent_ = node;
+      node->children_.push_back(child);
+    }
+    // The interval of |successor| contains everything now below |bb|.
+    node->dfs_num_pre_ = removed->dfs_num_pre_;
+    node->dfs_num_post_ = removed->dfs_num_post_;
+  }
+  // In the first case the numbering of the remaining nodes is still valid.
+  nodes_.erase(successor->id());
+}
+
 void DominatorTree::DumpTreeAsDot(std::ostream& out_stream) const {
   out_stream << "digraph {\n";
   Visit([&out_stream](const DominatorTreeNode* node) {
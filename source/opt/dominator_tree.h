@@ -276,6 +276,13 @@ class DominatorTree {
   // Recomputes the DF numbering of the tree.
   void ResetDFNumbering();
 
+  // Updates the tree after |successor| was merged into |bb|, so that it does
+  // not have to be rebuilt from scratch.  Before the merge, |successor| was
+  // the only successor of |bb| and |bb| the only predecessor of |successor|.
+  // Must be called after the instructions were moved into |bb|, but before
+  // |successor| is deleted.
+  void MergeBlocks(BasicBlock* bb, BasicBlock* successor);
+
  private:
   // Wrapper function which gets the list of pairs of each BasicBlocks to its
   // immediately  dominating BasicBlock and stores the result in the edges
@@ -289,6 +296,12 @@ class DominatorTree {
       const Function* f, const BasicBlock* dummy_start_node,
       std::vector<std::pair<BasicBlock*, BasicBlock*>>* edges);
 
+  // Replaces |node| by |replacement| in the list of children of its parent,
+  // or in the list of roots if it has no parent.  |replacement| takes over
+  // the parent of |node|.
+  void ReplaceInParent(DominatorTreeNode* node,
+                       DominatorTreeNode* replacement);
+
   // The roots of the tree.
   std::vector<DominatorTreeNode*> roots_;
 
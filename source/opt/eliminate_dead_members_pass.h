@@ -38,7 +38,6 @@ class EliminateDeadMembersPass : public MemPass {
            IRContext::kAnalysisLoopAnalysis |
            IRContext::kAnalysisScalarEvolution |
            IRContext::kAnalysisRegisterPressure |
-           IRContext::kAnalysisValueNumberTable |
            IRContext::kAnalysisStructuredCFG |
            IRContext::kAnalysisBuiltinVarId |
            IRContext::kAnalysisIdToFuncMapping;
@@ -179,6 +179,16 @@ class DebugScope {
 // appearing before this instruction. Note that the result id of an instruction
 // should never change after the instruction being built. If the result id
 // needs to change, the user should create a new instruction instead.
+//
+// Instructions, their operands and basic blocks come from the global
+// allocator rather than from an arena owned by the IRContext. Instructions
+// are owned through std::unique_ptr and intrusive lists at many creation
+// sites, move between blocks and functions, and are deleted one at a time by
+// IRContext::KillInst, so a bulk-released arena would have to change every
+// owner. Recycling freed instruction storage was tried as a cheaper
+// alternative, but it hides use-after-free bugs from ASan and the fuzzers
+// and showed no measurable gain. Operand words already live inline in a
+// SmallVector.
 class Instruction : public utils::IntrusiveNodeBase<Instruction> {
  public:
   using OperandList = std::vector<Operand>;
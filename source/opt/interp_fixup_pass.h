@@ -40,7 +40,6 @@ class InterpFixupPass : public Pass {
            IRContext::kAnalysisLoopAnalysis | IRContext::kAnalysisNameMap |
            IRContext::kAnalysisScalarEvolution |
            IRContext::kAnalysisRegisterPressure |
-           IRContext::kAnalysisValueNumberTable |
            IRContext::kAnalysisStructuredCFG |
            IRContext::kAnalysisBuiltinVarId |
            IRContext::kAnalysisIdToFuncMapping | IRContext::kAnalysisTypes |
@@ -99,6 +99,44 @@ void IRContext::InvalidateAnalysesExceptFor(
   InvalidateAnalyses(static_cast<IRContext::Analysis>(analyses_to_invalidate));
 }
 
+void IRContext::InvalidateAnalysesExceptFor(
+    const Function* f, IRContext::Analysis preserved_analyses) {
+  uint32_t analyses_to_invalidate = valid_analyses_ & (~preserved_analyses);
+
+  if (analyses_to_invalidate & kAnalysisCFG) {
+    // The CFG of |f| is recomputed the next time the CFG is requested, since
+    // the function may still be in the middle of being changed.
+    functions_with_stale_cfg_.insert(f->result_id());
+    // The dominator trees of |f| are built from its CFG.
+    analyses_to_invalidate |= kAnalysisDominatorAnalysis;
+  }
+  if (analyses_to_invalidate & kAnalysisDominatorAnalysis) {
+    dominator_trees_.erase(f);
+    post_dominator_trees_.erase(f);
+  }
+  if (analyses_to_invalidate & kAnalysisLoopAnalysis) {
+    loop_descriptors_.erase(f);
+  }
+  if (analyses_to_invalidate & kAnalysisRegisterPressure) {
+    reg_pressure_->Invalidate(f);
+  }
+
+  const uint32_t per_function_analyses =
+      kAnalysisCFG | kAnalysisDominatorAnalysis | kAnalysisLoopAnalysis |
+      kAnalysisRegisterPressure;
+  InvalidateAnalyses(static_cast<IRContext::Analysis>(
+      analyses_to_invalidate & ~per_function_analyses));
+}
+
+void IRContext::UpdateStaleCFGs() {
+  for (auto& fn : *module()) {
+    if (functions_with_stale_cfg_.count(fn.result_id())) {
+      cfg_->ReanalyzeFunction(&fn);
+    }
+  }
+  functions_with_stale_cfg_.clear();
+}
+
 void IRContext::InvalidateAnalyses(IRContext::Analysis analyses_to_invalidate) {
   // The ConstantManager and DebugInfoManager contain Type pointers. If the
   // TypeManager goes away, the ConstantManager and DebugInfoManager have to
@@ -132,6 +170,7 @@ void IRContext::InvalidateAnalyses(IRContext::Analysis analyses_to_invalidate) {
   }
   if (analyses_to_invalidate & kAnalysisCFG) {
     cfg_.reset(nullptr);
+    functions_with_stale_cfg_.clear();
   }
   if (analyses_to_invalidate & kAnalysisDominatorAnalysis) {
     dominator_trees_.clear();
@@ -183,6 +222,9 @@ Instruction* IRContext::KillInst(Instruction* inst) {
   if (AreAnalysesValid(kAnalysisInstrToBlockMapping)) {
     instr_to_block_.erase(inst);
   }
+  if (AreAnalysesValid(kAnalysisValueNumberTable)) {
+    vn_table_->RemoveInstruction(inst);
+  }
   if (AreAnalysesValid(kAnalysisDecorations)) {
     if (inst->IsDecoration()) {
       decoration_mgr_->RemoveDecoration(inst);
@@ -1064,6 +1106,20 @@ PostDominatorAnalysis* IRContext::GetPostDominatorAnalysis(const Function* f) {
   return &post_dominator_trees_[f];
 }
 
+void IRContext::UpdateDominatorsForMergedBlocks(BasicBlock* bb,
+                                                BasicBlock* successor) {
+  if (!AreAnalysesValid(kAnalysisDominatorAnalysis)) return;
+  const Function* f = bb->GetParent();
+  auto dom = dominator_trees_.find(f);
+  if (dom != dominator_trees_.end()) {
+    dom->second.GetDomTree().MergeBlocks(bb, successor);
+  }
+  auto post_dom = post_dominator_trees_.find(f);
+  if (post_dom != post_dominator_trees_.end()) {
+    post_dom->second.GetDomTree().MergeBlocks(bb, successor);
+  }
+}
+
 bool IRContext::CheckCFG() {
   std::unordered_map<uint32_t, std::vector<uint32_t>> real_preds;
   if (!AreAnalysesValid(kAnalysisCFG)) {
@@ -403,7 +403,10 @@ class IRContext {
 
   // Sets the message consumer to the given |consumer|. |consumer| which will be
   // invoked every time there is a message to be communicated to the outside.
-  void SetMessageConsumer(MessageConsumer c) { consumer_ = std::move(c); }
+  void SetMessageConsumer(MessageConsumer c) {
+    consumer_ = std::move(c);
+    SetContextMessageConsumer(syntax_context_, consumer_);
+  }
 
   // Returns the reference to the message consumer for this pass.
   const MessageConsumer& consumer() const { return consumer_; }
@@ -414,6 +417,16 @@ class IRContext {
   // Invalidates all of the analyses except for those in |preserved_analyses|.
   void InvalidateAnalysesExceptFor(Analysis preserved_analyses);
 
+  // Invalidates all of the analyses except for those in |preserved_analyses|,
+  // after a change that was confined to the function |f|.  The analyses that
+  // are kept per function (dominators, loops and register pressure) are only
+  // discarded for |f|, and only the part of the CFG for |f| is recomputed the
+  // next time the CFG is requested, so that these analyses remain valid for
+  // the other functions.  The other analyses are invalidated for the whole
+  // module.
+  void InvalidateAnalysesExceptFor(const Function* f,
+                                   Analysis preserved_analyses);
+
   // Invalidates the analyses marked in |analyses_to_invalidate|.
   void InvalidateAnalyses(Analysis analyses_to_invalidate);
 
@@ -534,6 +547,8 @@ class IRContext {
   CFG* cfg() {
     if (!AreAnalysesValid(kAnalysisCFG)) {
       BuildCFG();
+    } else if (!functions_with_stale_cfg_.empty()) {
+      UpdateStaleCFGs();
     }
     return cfg_.get();
   }
@@ -557,6 +572,12 @@ class IRContext {
     post_dominator_trees_.erase(f);
   }
 
+  // Updates the cached dominator and post-dominator trees of the function of
+  // |bb| after |successor| was merged into |bb|.  See
+  // DominatorTree::MergeBlocks.  The trees are updated in place, so this does
+  // not need the CFG analysis to be up to date.
+  void UpdateDominatorsForMergedBlocks(BasicBlock* bb, BasicBlock* successor);
+
   // Return the next available SSA id and increment it.  Returns 0 if the
   // maximum SSA id has been reached.
   inline uint32_t TakeNextId() {
@@ -725,9 +746,14 @@ class IRContext {
 
   void BuildCFG() {
     cfg_ = MakeUnique<CFG>(module());
+    functions_with_stale_cfg_.clear();
     valid_analyses_ = valid_analyses_ | kAnalysisCFG;
   }
 
+  // Recomputes the part of the CFG for the functions in
+  // |functions_with_stale_cfg_|.
+  void UpdateStaleCFGs();
+
   void BuildScalarEvolutionAnalysis() {
     scalar_evolution_analysis_ = MakeUnique<ScalarEvolutionAnalysis>(this);
     valid_analyses_ = valid_analyses_ | kAnalysisScalarEvolution;
@@ -884,6 +910,9 @@ class IRContext {
 
   // The CFG for all the functions in |module_|.
   std::unique_ptr<CFG> cfg_;
+  // The result ids of the functions whose part of |cfg_| is out of date.  See
+  // InvalidateAnalysesExceptFor(const Function*, Analysis).
+  std::unordered_set<uint32_t> functions_with_stale_cfg_;
 
   // Each function in the module will create its own dominator tree. We cache
   // the result so it doesn't need to be rebuilt each time.
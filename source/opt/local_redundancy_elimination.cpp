@@ -21,7 +21,7 @@ namespace opt {
 
 Pass::Status LocalRedundancyEliminationPass::Process() {
   bool modified = false;
-  ValueNumberTable vnTable(context());
+  const ValueNumberTable& vnTable = *context()->GetValueNumberTable();
 
   for (auto& func : *get_module()) {
     for (auto& bb : func) {
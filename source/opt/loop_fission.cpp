@@ -480,7 +480,7 @@ Pass::Status LoopFissionPass::Process() {
           Loop* second_loop = impl.SplitLoop();
           changed = true;
           context()->InvalidateAnalysesExceptFor(
-              IRContext::kAnalysisLoopAnalysis);
+              &f, IRContext::kAnalysisLoopAnalysis);
 
           // If the newly created loop meets the criteria to be split, split it
           // again.
@@ -724,6 +724,7 @@ void LoopFusion::Fuse() {
 
   // Invalidate analyses.
   context_->InvalidateAnalysesExceptFor(
+      containing_function_,
       IRContext::Analysis::kAnalysisInstrToBlockMapping |
       IRContext::Analysis::kAnalysisLoopAnalysis |
       IRContext::Analysis::kAnalysisDefUse | IRContext::Analysis::kAnalysisCFG);
@@ -469,6 +469,7 @@ void LoopPeeling::PeelBefore(uint32_t peel_factor) {
       });
 
   context_->InvalidateAnalysesExceptFor(
+      loop_utils_.GetFunction(),
       IRContext::kAnalysisDefUse | IRContext::kAnalysisInstrToBlockMapping |
       IRContext::kAnalysisLoopAnalysis | IRContext::kAnalysisCFG);
 }
@@ -561,6 +562,7 @@ void LoopPeeling::PeelAfter(uint32_t peel_factor) {
       });
 
   context_->InvalidateAnalysesExceptFor(
+      loop_utils_.GetFunction(),
       IRContext::kAnalysisDefUse | IRContext::kAnalysisInstrToBlockMapping |
       IRContext::kAnalysisLoopAnalysis | IRContext::kAnalysisCFG);
 }
@@ -431,7 +431,7 @@ void LoopUnrollerUtilsImpl::PartiallyUnrollResidualFactor(Loop* loop,
 
   // Reset the usedef analysis.
   context_->InvalidateAnalysesExceptFor(
-      IRContext::Analysis::kAnalysisLoopAnalysis);
+      &function_, IRContext::Analysis::kAnalysisLoopAnalysis);
   analysis::DefUseManager* def_use_manager = context_->get_def_use_mgr();
 
   // The loop condition.
@@ -503,7 +503,7 @@ void LoopUnrollerUtilsImpl::PartiallyUnrollResidualFactor(Loop* loop,
   }
 
   context_->InvalidateAnalysesExceptFor(
-      IRContext::Analysis::kAnalysisLoopAnalysis);
+      &function_, IRContext::Analysis::kAnalysisLoopAnalysis);
 
   context_->ReplaceAllUsesWith(loop->GetMergeBlock()->id(), new_merge_id);
 
@@ -552,6 +552,7 @@ void LoopUnrollerUtilsImpl::RemoveDeadInstructions() {
 
 void LoopUnrollerUtilsImpl::ReplaceInductionUseWithFinalValue(Loop* loop) {
   context_->InvalidateAnalysesExceptFor(
+      &function_,
       IRContext::Analysis::kAnalysisLoopAnalysis |
       IRContext::Analysis::kAnalysisDefUse |
       IRContext::Analysis::kAnalysisInstrToBlockMapping);
@@ -596,6 +597,7 @@ void LoopUnrollerUtilsImpl::FullyUnroll(Loop* loop) {
   RemoveDeadInstructions();
   // Invalidate all analyses.
   context_->InvalidateAnalysesExceptFor(
+      &function_,
       IRContext::Analysis::kAnalysisLoopAnalysis |
       IRContext::Analysis::kAnalysisDefUse);
 }
@@ -415,7 +415,7 @@ class LoopUnswitch {
     ordered_loop_blocks_.clear();
 
     context_->InvalidateAnalysesExceptFor(
-        IRContext::Analysis::kAnalysisLoopAnalysis);
+        function_, IRContext::Analysis::kAnalysisLoopAnalysis);
   }
 
  private:
@@ -428,6 +428,7 @@ void LoopUtils::CreateLoopDedicatedExits() {
 
   if (made_change) {
     context_->InvalidateAnalysesExceptFor(
+        &function_,
         PreservedAnalyses | IRContext::kAnalysisCFG |
         IRContext::Analysis::kAnalysisLoopAnalysis);
   }
@@ -471,6 +472,7 @@ void LoopUtils::MakeLoopClosedSSA() {
   }
 
   context_->InvalidateAnalysesExceptFor(
+      &function_,
       IRContext::Analysis::kAnalysisCFG |
       IRContext::Analysis::kAnalysisDominatorAnalysis |
       IRContext::Analysis::kAnalysisLoopAnalysis);
@@ -65,6 +65,36 @@ Optimizer::PassToken& Optimizer::PassToken::operator=(PassToken&& that) {
 
 Optimizer::PassToken::~PassToken() {}
 
+struct OptimizerModule::Impl {
+  std::unique_ptr<opt::IRContext> context;  // Null until a module is loaded.
+  spv_target_env target_env = SPV_ENV_UNIVERSAL_1_0;  // Env it was loaded for.
+};
+
+OptimizerModule::OptimizerModule() : impl_(MakeUnique<Impl>()) {}
+
+OptimizerModule::OptimizerModule(OptimizerModule&& that)
+    : impl_(MakeUnique<Impl>()) {
+  impl_->context = std::move(that.impl_->context);
+  impl_->target_env = that.impl_->target_env;
+}
+
+OptimizerModule& OptimizerModule::operator=(OptimizerModule&& that) {
+  impl_->context = std::move(that.impl_->context);
+  impl_->target_env = that.impl_->target_env;
+  return *this;
+}
+
+OptimizerModule::~OptimizerModule() {}
+
+bool OptimizerModule::IsLoaded() const { return impl_->context != nullptr; }
+
+bool OptimizerModule::ToBinary(std::vector<uint32_t>* binary) const {
+  if (!IsLoaded()) return false;
+  binary->clear();
+  impl_->context->module()->ToBinary(binary, /* skip_nop = */ true);
+  return true;
+}
+
 struct Optimizer::Impl {
   explicit Impl(spv_target_env env) : target_env(env), pass_manager() {}
 
@@ -653,25 +683,75 @@ bool Optimizer::Run(const uint32_t* original_binary,
                     const size_t original_binary_size,
                     std::vector<uint32_t>* optimized_binary,
                     const spv_optimizer_options opt_options) const {
+  OptimizerModule module;
+  if (!Load(original_binary, original_binary_size, &module, opt_options) ||
+      !Run(&module, opt_options)) {
+    return false;
+  }
+
+  // Note that |original_binary| and |optimized_binary| may share the same
+  // buffer and the below will invalidate |original_binary|.
+  return module.ToBinary(optimized_binary);
+}
+
+bool Optimizer::Load(const uint32_t* binary, const size_t binary_size,
+                     OptimizerModule* module) const {
+  return Load(binary, binary_size, module, OptimizerOptions());
+}
+
+bool Optimizer::Load(const uint32_t* binary, const size_t binary_size,
+                     OptimizerModule* module,
+                     const spv_optimizer_options opt_options) const {
+  module->impl_->context.reset();
+
   spvtools::SpirvTools tools(impl_->target_env);
   tools.SetMessageConsumer(impl_->pass_manager.consumer());
   if (opt_options->run_validator_ &&
-      !tools.Validate(original_binary, original_binary_size,
-                      &opt_options->val_options_)) {
+      !tools.Validate(binary, binary_size, &opt_options->val_options_)) {
     return false;
   }
 
-  std::unique_ptr<opt::IRContext> context = BuildModule(
-      impl_->target_env, consumer(), original_binary, original_binary_size);
+  module->impl_->context =
+      BuildModule(impl_->target_env, consumer(), binary, binary_size);
+  module->impl_->target_env = impl_->target_env;
+  return module->impl_->context != nullptr;
+}
+
+bool Optimizer::Run(OptimizerModule* module) const {
+  return Run(module, OptimizerOptions());
+}
+
+bool Optimizer::Run(OptimizerModule* module,
+                    const spv_optimizer_options opt_options) const {
+  opt::IRContext* context = module->impl_->context.get();
   if (context == nullptr) return false;
 
+  // The grammar of the module is the one of the environment it was loaded
+  // for, so it can't be optimized for a different one.
+  if (module->impl_->target_env != impl_->target_env) {
+    Errorf(consumer(), nullptr, {},
+           "The module was loaded for target environment %s, but the "
+           "optimizer targets %s.",
+           spvTargetEnvDescription(module->impl_->target_env),
+           spvTargetEnvDescription(impl_->target_env));
+    return false;
+  }
+
+  // Messages go to this optimizer's consumer, not to the one of the optimizer
+  // that loaded the module.
+  context->SetMessageConsumer(consumer());
   context->set_max_id_bound(opt_options->max_id_bound_);
   context->set_preserve_bindings(opt_options->preserve_bindings_);
   context->set_preserve_spec_constants(opt_options->preserve_spec_constants_);
 
+#ifndef NDEBUG
+  std::vector<uint32_t> binary_before;
+  context->module()->ToBinary(&binary_before, /* skip_nop = */ false);
+#endif  // !NDEBUG
+
   impl_->pass_manager.SetValidatorOptions(&opt_options->val_options_);
   impl_->pass_manager.SetTargetEnv(impl_->target_env);
-  auto status = impl_->pass_manager.Run(context.get());
+  auto status = impl_->pass_manager.Run(context);
 
   if (status == opt::Pass::Status::Failure) {
     return false;
@@ -686,30 +766,17 @@ bool Optimizer::Run(const uint32_t* original_binary,
   // contains DebugScope or OpLine/OpNoLine instructions.
   if (status == opt::Pass::Status::SuccessWithoutChange &&
       !context->module()->ContainsDebugInfo()) {
-    std::vector<uint32_t> optimized_binary_with_nop;
-    context->module()->ToBinary(&optimized_binary_with_nop,
-                                /* skip_nop = */ false);
-    assert(optimized_binary_with_nop.size() == original_binary_size &&
+    std::vector<uint32_t> binary_after;
+    context->module()->ToBinary(&binary_after, /* skip_nop = */ false);
+    assert(binary_after.size() == binary_before.size() &&
            "Binary size unexpectedly changed despite the optimizer saying "
            "there was no change");
-
-    // Compare the magic number to make sure the binaries were encoded in the
-    // endianness.  If not, the contents of the binaries will be different, so
-    // do not check the contents.
-    if (optimized_binary_with_nop[0] == original_binary[0]) {
-      assert(memcmp(optimized_binary_with_nop.data(), original_binary,
-                    original_binary_size) == 0 &&
-             "Binary content unexpectedly changed despite the optimizer saying "
-             "there was no change");
-    }
+    assert(binary_after == binary_before &&
+           "Binary content unexpectedly changed despite the optimizer saying "
+           "there was no change");
   }
 #endif  // !NDEBUG
 
-  // Note that |original_binary| and |optimized_binary| may share the same
-  // buffer and the below will invalidate |original_binary|.
-  optimized_binary->clear();
-  context->module()->ToBinary(optimized_binary, /* skip_nop = */ true);
-
   return true;
 }
 
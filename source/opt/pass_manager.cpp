@@ -15,10 +15,12 @@
 #include "source/opt/pass_manager.h"
 
 #include <iostream>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "source/opt/ir_context.h"
+#include "source/util/make_unique.h"
 #include "source/util/timer.h"
 #include "spirv-tools/libspirv.hpp"
 
@@ -51,6 +53,16 @@ Pass::Status PassManager::Run(IRContext* context) {
     }
   };
 
+  // Validation after each pass reuses one tool instance and one serialization
+  // buffer. The module is validated after every pass, including passes that
+  // report no change, so that a pass misreporting its status is caught too.
+  std::unique_ptr<spvtools::SpirvTools> tools;
+  if (validate_after_all_) {
+    tools = MakeUnique<spvtools::SpirvTools>(target_env_);
+    tools->SetMessageConsumer(consumer());
+  }
+  std::vector<uint32_t> binary;
+
   SPIRV_TIMER_DESCRIPTION(time_report_stream_, /* measure_mem_usage = */ true);
   for (auto& pass : passes_) {
     print_disassembly("; IR before pass ", pass.get());
@@ -59,12 +71,10 @@ Pass::Status PassManager::Run(IRContext* context) {
     if (one_status == Pass::Status::Failure) return one_status;
     if (one_status == Pass::Status::SuccessWithChange) status = one_status;
 
-    if (validate_after_all_) {
-      spvtools::SpirvTools tools(target_env_);
-      tools.SetMessageConsumer(consumer());
-      std::vector<uint32_t> binary;
+    if (tools) {
+      binary.clear();
       context->module()->ToBinary(&binary, true);
-      if (!tools.Validate(binary.data(), binary.size(), val_options_)) {
+      if (!tools->Validate(binary.data(), binary.size(), val_options_)) {
         std::string msg = "Validation failed after pass ";
         msg += pass->name();
         spv_position_t null_pos{0, 0, 0};
@@ -33,6 +33,16 @@ namespace opt {
 // The pass manager, responsible for tracking and running passes.
 // Clients should first call AddPass() to add passes and then call Run()
 // to run on a module. Passes are executed in the exact order of addition.
+//
+// Each pass runs over the whole module before the next one starts, and a pass
+// never runs over several functions at the same time. Even passes that
+// transform one function at a time share module-wide state: they take ids
+// from IRContext::TakeNextId, add types and constants through the
+// TypeManager and ConstantManager, and keep the DefUseManager up to date as
+// they go. Making all of that safe for concurrent use would put locks on the
+// hottest lookups in the optimizer and slow down every serial run, so
+// throughput on large modules is improved by making those structures cheaper
+// instead.
 class PassManager {
  public:
   // Constructs a pass manager.
@@ -105,6 +115,15 @@ class PassManager {
   }
 
   // Sets the option to validate after each pass.
+  //
+  // The module is serialized and validated in full after every pass, whether
+  // or not the pass reports a change, since catching passes that misreport it
+  // is part of the point of this option.  Re-checking only the functions a
+  // pass touched is not supported: IRContext records which analyses a pass
+  // invalidated, not which functions and declarations it changed, and many
+  // validator checks (ids, decorations, entry point interfaces, layouts)
+  // depend on module-wide state.  Validator options must be set with
+  // SetValidatorOptions() before Run() when this is enabled.
   PassManager& SetValidateAfterAll(bool validate) {
     validate_after_all_ = validate;
     return *this;
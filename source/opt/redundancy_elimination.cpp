@@ -21,7 +21,7 @@ namespace opt {
 
 Pass::Status RedundancyEliminationPass::Process() {
   bool modified = false;
-  ValueNumberTable vnTable(context());
+  const ValueNumberTable& vnTable = *context()->GetValueNumberTable();
 
   for (auto& func : *get_module()) {
     if (func.IsDeclaration()) {
@@ -185,6 +185,9 @@ class LivenessAnalysis {
                 .first->second;
   }
 
+  // Discards the cached analysis of the function |f|, if any.
+  void Invalidate(const Function* f) { analysis_cache_.erase(f); }
+
  private:
   IRContext* context_;
   LivenessAnalysisMap analysis_cache_;
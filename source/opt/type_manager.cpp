@@ -144,9 +144,9 @@ void TypeManager::AnalyzeTypes(const Module& module) {
       for (auto dec : decorations) {
         AttachDecoration(*dec, type.type());
       }
-      auto pair = type_pool_.insert(type.ReleaseType());
-      id_to_type_[type.id()] = pair.first->get();
-      type_to_id_[pair.first->get()] = type.id();
+      Type* pooled = AddToPool(type.ReleaseType());
+      id_to_type_[type.id()] = pooled;
+      type_to_id_[pooled] = type.id();
       id_to_incomplete_type_.erase(type.id());
     }
   }
@@ -157,20 +157,25 @@ void TypeManager::AnalyzeTypes(const Module& module) {
     id_to_type_[type.first] = type.second;
   }
 
-#ifndef NDEBUG
   // Check if the type pool contains two types that are the same.  This
   // is an indication that the hashing and comparison are wrong.  It
   // will cause a problem if the type pool gets resized and everything
   // is rehashed.
+  assert(!PoolHasDuplicateTypes() &&
+         "Type pool contains two types that are the same.");
+}
+
+bool TypeManager::PoolHasDuplicateTypes() const {
+  // IsSame takes two types of the same pool to be different without looking
+  // at them, so the types are compared with IsSameImpl instead.
   for (auto& i : type_pool_) {
     for (auto& j : type_pool_) {
-      Type* ti = i.get();
-      Type* tj = j.get();
-      assert((ti == tj || !ti->IsSame(tj)) &&
-             "Type pool contains two types that are the same.");
+      if (i == j) continue;
+      Type::IsSameCache seen;
+      if (i->IsSameImpl(j.get(), &seen)) return true;
     }
   }
-#endif
+  return false;
 }
 
 void TypeManager::RemoveId(uint32_t id) {
@@ -539,7 +544,7 @@ Type* TypeManager::RebuildType(uint32_t type_id, const Type& type) {
 #define DefineNoSubtypeCase(kind)             \
   case Type::k##kind:                         \
     rebuilt_ty.reset(type.Clone().release()); \
-    return type_pool_.insert(std::move(rebuilt_ty)).first->get()
+    return AddToPool(std::move(rebuilt_ty))
 
     DefineNoSubtypeCase(Void);
     DefineNoSubtypeCase(Bool);
@@ -679,7 +684,13 @@ Type* TypeManager::RebuildType(uint32_t type_id, const Type& type) {
     rebuilt_ty->AddDecoration(std::move(copy));
   }
 
-  return type_pool_.insert(std::move(rebuilt_ty)).first->get();
+  return AddToPool(std::move(rebuilt_ty));
+}
+
+Type* TypeManager::AddToPool(std::unique_ptr<Type> type) {
+  Type* pooled = type_pool_.insert(std::move(type)).first->get();
+  pooled->SetPool(&type_pool_);
+  return pooled;
 }
 
 void TypeManager::RegisterType(uint32_t id, const Type& type) {
@@ -930,10 +941,9 @@ Type* TypeManager::RecordIfTypeDefinition(const Instruction& inst) {
   for (auto dec : decorations) {
     AttachDecoration(*dec, type);
   }
-  std::unique_ptr<Type> unique(type);
-  auto pair = type_pool_.insert(std::move(unique));
-  id_to_type_[id] = pair.first->get();
-  type_to_id_[pair.first->get()] = id;
+  Type* pooled = AddToPool(std::unique_ptr<Type>(type));
+  id_to_type_[id] = pooled;
+  type_to_id_[pooled] = id;
   return type;
 }
 
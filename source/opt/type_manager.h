@@ -23,6 +23,7 @@
 
 #include "source/opt/module.h"
 #include "source/opt/types.h"
+#include "source/util/dense_id_map.h"
 #include "spirv-tools/libspirv.hpp"
 
 namespace spvtools {
@@ -70,7 +71,7 @@ struct CompareTypeUniquePointers {
 // A class for managing the SPIR-V type hierarchy.
 class TypeManager {
  public:
-  using IdToTypeMap = std::unordered_map<uint32_t, Type*>;
+  using IdToTypeMap = utils::DenseIdMap<Type*>;
 
   // Constructs a type manager from the given |module|. All internal messages
   // will be communicated to the outside via the given message |consumer|.
@@ -91,6 +92,10 @@ class TypeManager {
   uint32_t GetId(const Type* type) const;
   // Returns the number of types hold in this manager.
   size_t NumTypes() const { return id_to_type_.size(); }
+  // Returns true if the type pool holds two types that are the same.  The
+  // types are compared by their structure, without relying on pooled types
+  // being unique, so this checks that invariant.
+  bool PoolHasDuplicateTypes() const;
   // Iterators for all types contained in this manager.
   IdToTypeMap::const_iterator begin() const { return id_to_type_.cbegin(); }
   IdToTypeMap::const_iterator end() const { return id_to_type_.cend(); }
@@ -264,6 +269,10 @@ class TypeManager {
   // The re-built type will have ID |type_id|.
   Type* RebuildType(uint32_t type_id, const Type& type);
 
+  // Adds |type| to |type_pool_| unless the pool already holds the same type,
+  // and returns the pooled type. Pooled types must not be modified.
+  Type* AddToPool(std::unique_ptr<Type> type);
+
   // Completes the incomplete type |type|, by replaces all references to
   // ForwardPointer by the defining Pointer.
   void ReplaceForwardPointers(Type* type);
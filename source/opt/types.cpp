@@ -191,13 +191,24 @@ size_t Type::ComputeHashValue(size_t hash, SeenTypes* seen) const {
   // n) search in a complex data structure (eg std::set) for the generally small
   // number of nodes.  It also skips the overhead of an new/delete per Type
   // (when inserting/removing from a set).
-  if (std::find(seen->begin(), seen->end(), this) != seen->end()) {
+  if (std::find(seen->path.begin(), seen->path.end(), this) !=
+      seen->path.end()) {
+    seen->found_cycle = true;
     return hash;
   }
 
-  seen->push_back(this);
+  // A type that does not refer back to itself hashes the same wherever the
+  // traversal reaches it, so its pooled hash can stand in for its structure.
+  if (pool_ && !pooled_hash_has_cycle_) {
+    return hash_combine(hash, pooled_hash_);
+  }
+  return hash_combine(hash, ComputeOwnHash(seen));
+}
+
+size_t Type::ComputeOwnHash(SeenTypes* seen) const {
+  seen->path.push_back(this);
 
-  hash = hash_combine(hash, uint32_t(kind_));
+  size_t hash = hash_combine(0, uint32_t(kind_));
   for (const auto& d : decorations_) {
     hash = hash_combine(hash, d);
   }
@@ -241,15 +252,27 @@ size_t Type::ComputeHashValue(size_t hash, SeenTypes* seen) const {
       break;
   }
 
-  seen->pop_back();
+  seen->path.pop_back();
   return hash;
 }
 
 size_t Type::HashValue() const {
+  if (pool_) return hash_combine(0, pooled_hash_);
   SeenTypes seen;
   return ComputeHashValue(0, &seen);
 }
 
+void Type::SetPool(const void* pool) {
+  if (pool_ == pool) return;
+  // Compute the hash from the structure of this type, while the types it is
+  // made of may already be pooled.
+  pool_ = nullptr;
+  SeenTypes seen;
+  pooled_hash_ = ComputeOwnHash(&seen);
+  pooled_hash_has_cycle_ = seen.found_cycle;
+  pool_ = pool;
+}
+
 uint64_t Type::NumberOfComponents() const {
   switch (kind()) {
     case kVector:
@@ -319,7 +342,7 @@ bool Vector::IsSameImpl(const Type* that, IsSameCache* seen) const {
   const Vector* vt = that->AsVector();
   if (!vt) return false;
   return count_ == vt->count_ &&
-         element_type_->IsSameImpl(vt->element_type_, seen) &&
+         element_type_->IsSameNested(vt->element_type_, seen) &&
          HasSameDecorations(that);
 }
 
@@ -345,7 +368,7 @@ bool Matrix::IsSameImpl(const Type* that, IsSameCache* seen) const {
   const Matrix* mt = that->AsMatrix();
   if (!mt) return false;
   return count_ == mt->count_ &&
-         element_type_->IsSameImpl(mt->element_type_, seen) &&
+         element_type_->IsSameNested(mt->element_type_, seen) &&
          HasSameDecorations(that);
 }
 
@@ -381,7 +404,7 @@ bool Image::IsSameImpl(const Type* that, IsSameCache* seen) const {
   return dim_ == it->dim_ && depth_ == it->depth_ && arrayed_ == it->arrayed_ &&
          ms_ == it->ms_ && sampled_ == it->sampled_ && format_ == it->format_ &&
          access_qualifier_ == it->access_qualifier_ &&
-         sampled_type_->IsSameImpl(it->sampled_type_, seen) &&
+         sampled_type_->IsSameNested(it->sampled_type_, seen) &&
          HasSameDecorations(that);
 }
 
@@ -402,7 +425,7 @@ size_t Image::ComputeExtraStateHash(size_t hash, SeenTypes* seen) const {
 bool SampledImage::IsSameImpl(const Type* that, IsSameCache* seen) const {
   const SampledImage* sit = that->AsSampledImage();
   if (!sit) return false;
-  return image_type_->IsSameImpl(sit->image_type_, seen) &&
+  return image_type_->IsSameNested(sit->image_type_, seen) &&
          HasSameDecorations(that);
 }
 
@@ -428,7 +451,7 @@ Array::Array(const Type* type, const Array::LengthInfo& length_info_arg)
 bool Array::IsSameImpl(const Type* that, IsSameCache* seen) const {
   const Array* at = that->AsArray();
   if (!at) return false;
-  bool is_same = element_type_->IsSameImpl(at->element_type_, seen);
+  bool is_same = element_type_->IsSameNested(at->element_type_, seen);
   is_same = is_same && HasSameDecorations(that);
   is_same = is_same && (length_info_.words == at->length_info_.words);
   return is_same;
@@ -467,7 +490,7 @@ RuntimeArray::RuntimeArray(const Type* type)
 bool RuntimeArray::IsSameImpl(const Type* that, IsSameCache* seen) const {
   const RuntimeArray* rat = that->AsRuntimeArray();
   if (!rat) return false;
-  return element_type_->IsSameImpl(rat->element_type_, seen) &&
+  return element_type_->IsSameNested(rat->element_type_, seen) &&
          HasSameDecorations(that);
 }
 
@@ -512,7 +535,7 @@ bool Struct::IsSameImpl(const Type* that, IsSameCache* seen) const {
   if (!HasSameDecorations(that)) return false;
 
   for (size_t i = 0; i < element_types_.size(); ++i) {
-    if (!element_types_[i]->IsSameImpl(st->element_types_[i], seen))
+    if (!element_types_[i]->IsSameNested(st->element_types_[i], seen))
       return false;
   }
   for (const auto& p : element_decorations_) {
@@ -572,7 +595,7 @@ bool Pointer::IsSameImpl(const Type* that, IsSameCache* seen) const {
   if (!p.second) {
     return true;
   }
-  bool same_pointee = pointee_type_->IsSameImpl(pt->pointee_type_, seen);
+  bool same_pointee = pointee_type_->IsSameNested(pt->pointee_type_, seen);
   seen->erase(p.first);
   if (!same_pointee) {
     return false;
@@ -603,10 +626,10 @@ Function::Function(const Type* ret_type, std::vector<const Type*>& params)
 bool Function::IsSameImpl(const Type* that, IsSameCache* seen) const {
   const Function* ft = that->AsFunction();
   if (!ft) return false;
-  if (!return_type_->IsSameImpl(ft->return_type_, seen)) return false;
+  if (!return_type_->IsSameNested(ft->return_type_, seen)) return false;
   if (param_types_.size() != ft->param_types_.size()) return false;
   for (size_t i = 0; i < param_types_.size(); ++i) {
-    if (!param_types_[i]->IsSameImpl(ft->param_types_[i], seen)) return false;
+    if (!param_types_[i]->IsSameNested(ft->param_types_[i], seen)) return false;
   }
   return HasSameDecorations(that);
 }
@@ -706,7 +729,7 @@ bool CooperativeMatrixNV::IsSameImpl(const Type* that,
                                      IsSameCache* seen) const {
   const CooperativeMatrixNV* mt = that->AsCooperativeMatrixNV();
   if (!mt) return false;
-  return component_type_->IsSameImpl(mt->component_type_, seen) &&
+  return component_type_->IsSameNested(mt->component_type_, seen) &&
          scope_id_ == mt->scope_id_ && rows_id_ == mt->rows_id_ &&
          columns_id_ == mt->columns_id_ && HasSameDecorations(that);
 }
@@ -745,7 +768,7 @@ bool CooperativeMatrixKHR::IsSameImpl(const Type* that,
                                       IsSameCache* seen) const {
   const CooperativeMatrixKHR* mt = that->AsCooperativeMatrixKHR();
   if (!mt) return false;
-  return component_type_->IsSameImpl(mt->component_type_, seen) &&
+  return component_type_->IsSameNested(mt->component_type_, seen) &&
          scope_id_ == mt->scope_id_ && rows_id_ == mt->rows_id_ &&
          columns_id_ == mt->columns_id_ && HasSameDecorations(that);
 }
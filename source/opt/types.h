@@ -70,7 +70,13 @@ class Type {
  public:
   typedef std::set<std::pair<const Pointer*, const Pointer*>> IsSameCache;
 
-  using SeenTypes = spvtools::utils::SmallVector<const Type*, 8>;
+  // The state of a hash computation: the types on the path from the type
+  // being hashed to the current one, and whether the traversal came back to
+  // one of them.
+  struct SeenTypes {
+    spvtools::utils::SmallVector<const Type*, 8> path;
+    bool found_cycle = false;
+  };
 
   // Available subtypes.
   //
@@ -109,6 +115,15 @@ class Type {
 
   Type(Kind k) : kind_(k) {}
 
+  // Copies are never pooled, since they can be modified.
+  Type(const Type& that) : decorations_(that.decorations_), kind_(that.kind_) {}
+  Type& operator=(const Type& that) {
+    decorations_ = that.decorations_;
+    kind_ = that.kind_;
+    pool_ = nullptr;
+    return *this;
+  }
+
   virtual ~Type() = default;
 
   // Attaches a decoration directly on this type.
@@ -122,6 +137,8 @@ class Type {
   // Returns true if this type is exactly the same as |that| type, including
   // decorations.
   bool IsSame(const Type* that) const {
+    if (this == that) return true;
+    if (pool_ && pool_ == that->pool_) return false;
     IsSameCache seen;
     return IsSameImpl(that, &seen);
   }
@@ -131,6 +148,14 @@ class Type {
   // compared in a parent call to |IsSameImpl|.
   virtual bool IsSameImpl(const Type* that, IsSameCache* seen) const = 0;
 
+  // Same as IsSameImpl, for the types that make up a type.  Pooled types are
+  // compared by identity without looking at their structure.
+  bool IsSameNested(const Type* that, IsSameCache* seen) const {
+    if (this == that) return true;
+    if (pool_ && pool_ == that->pool_) return false;
+    return IsSameImpl(that, seen);
+  }
+
   // Returns a human-readable string to represent this type.
   virtual std::string str() const = 0;
 
@@ -163,11 +188,22 @@ class Type {
 
   bool operator==(const Type& other) const;
 
-  // Returns the hash value of this type.
+  // Returns the hash value of this type.  It is computed once for a pooled
+  // type, and on every call otherwise.
   size_t HashValue() const;
 
+  // Combines the hash value of this type into |hash| and returns the result.
+  // The hash of a pooled type that does not refer back to itself is reused
+  // rather than recomputed.
   size_t ComputeHashValue(size_t hash, SeenTypes* seen) const;
 
+  // Records that this type is owned by the type pool identified by |pool|.
+  // A pool holds at most one type of each structure, and neither its types
+  // nor the types they are made of are modified once pooled.  This lets a
+  // pooled type hash once, and lets two types of the same pool compare by
+  // identity.
+  void SetPool(const void* pool);
+
   // Returns the number of components in a composite type.  Returns 0 for a
   // non-composite type.
   uint64_t NumberOfComponents() const;
@@ -223,7 +259,20 @@ protected:
   // decorations.
   virtual void ClearDecorations() { decorations_.clear(); }
 
+  // Returns the hash of this type alone, before it is combined into the hash
+  // of an enclosing computation.
+  size_t ComputeOwnHash(SeenTypes* seen) const;
+
   Kind kind_;
+
+  // The pool owning this type, or null if the type is not pooled.
+  const void* pool_ = nullptr;
+  // For a pooled type, the result of ComputeOwnHash, and whether computing it
+  // came back to a type already on the path.  The hash of a type that refers
+  // back to itself depends on where the traversal starts, so it is only
+  // reused at the top level.
+  size_t pooled_hash_ = 0;
+  bool pooled_hash_has_cycle_ = false;
 };
 // clang-format on
 
@@ -18,6 +18,7 @@
 
 #include "source/opt/cfg.h"
 #include "source/opt/ir_context.h"
+#include "source/util/hash_combine.h"
 
 namespace spvtools {
 namespace opt {
@@ -35,7 +36,11 @@ uint32_t ValueNumberTable::GetValueNumber(Instruction* inst) const {
 }
 
 uint32_t ValueNumberTable::GetValueNumber(uint32_t id) const {
-  return GetValueNumber(context()->get_def_use_mgr()->GetDef(id));
+  auto id_to_val = id_to_value_.find(id);
+  if (id_to_val != id_to_value_.end()) {
+    return id_to_val->second;
+  }
+  return 0;
 }
 
 uint32_t ValueNumberTable::AssignValueNumber(Instruction* inst) {
@@ -112,40 +117,124 @@ uint32_t ValueNumberTable::AssignValueNumber(Instruction* inst) {
     }
   }
 
+  // TODO: Implement a normal form for opcodes that commute like integer
+  // addition.  This will let us know that a+b is the same value as b+a.
+
+  // Otherwise, we check if this value has been computed before.
+  GetCanonicalForm(*inst, &scratch_key_);
+  const size_t hash = utils::hash_combine(0, scratch_key_);
+  const uint32_t index =
+      FindComputedValue(scratch_key_, hash, inst->result_id());
+  if (index != kNoComputedValue) {
+    value = computed_values_[index].value_number;
+    id_to_value_[inst->result_id()] = value;
+    return value;
+  }
+
+  // If not, assign it a new value number.
+  value = TakeNextValueNumber();
+  id_to_value_[inst->result_id()] = value;
+  AddComputedValue(scratch_key_, hash, inst->result_id(), value);
+  return value;
+}
+
+void ValueNumberTable::RemoveInstruction(Instruction* inst) {
+  const uint32_t result_id = inst->result_id();
+  if (result_id == 0) {
+    return;
+  }
+  id_to_value_.erase(result_id);
+
+  // The computed value stays in the hash table so that probe sequences are not
+  // broken, but it can no longer be matched.
+  auto id_to_computed = id_to_computed_value_.find(result_id);
+  if (id_to_computed != id_to_computed_value_.end()) {
+    computed_values_[id_to_computed->second].result_id = 0;
+    id_to_computed_value_.erase(id_to_computed);
+  }
+}
+
+void ValueNumberTable::GetCanonicalForm(const Instruction& inst,
+                                        std::vector<uint32_t>* key) const {
   // Replace all of the operands by their value number.  The sign bit will be
-  // set to distinguish between an id and a value number.
-  Instruction value_ins(context(), inst->opcode(), inst->type_id(),
-                        inst->result_id(), {});
-  for (uint32_t o = 0; o < inst->NumInOperands(); ++o) {
-    const Operand& op = inst->GetInOperand(o);
+  // set to distinguish between an id and a value number.  Each operand is
+  // preceded by its type and its number of words.
+  key->clear();
+  key->push_back(uint32_t(inst.opcode()));
+  key->push_back(inst.type_id());
+  for (uint32_t o = 0; o < inst.NumInOperands(); ++o) {
+    const Operand& op = inst.GetInOperand(o);
+    key->push_back(uint32_t(op.type));
+    key->push_back(uint32_t(op.words.size()));
     if (spvIsIdType(op.type)) {
       uint32_t id_value = op.words[0];
       auto use_id_to_val = id_to_value_.find(id_value);
       if (use_id_to_val != id_to_value_.end()) {
-        id_value = (1 << 31) | use_id_to_val->second;
+        id_value = (1u << 31) | use_id_to_val->second;
       }
-      value_ins.AddOperand(Operand(op.type, {id_value}));
+      key->push_back(id_value);
     } else {
-      value_ins.AddOperand(Operand(op.type, op.words));
+      key->insert(key->end(), op.words.begin(), op.words.end());
     }
   }
+}
 
-  // TODO: Implement a normal form for opcodes that commute like integer
-  // addition.  This will let us know that a+b is the same value as b+a.
+uint32_t ValueNumberTable::FindComputedValue(const std::vector<uint32_t>& key,
+                                             size_t hash,
+                                             uint32_t result_id) const {
+  if (slots_.empty()) {
+    return kNoComputedValue;
+  }
 
-  // Otherwise, we check if this value has been computed before.
-  auto value_iterator = instruction_to_value_.find(value_ins);
-  if (value_iterator != instruction_to_value_.end()) {
-    value = id_to_value_[value_iterator->first.result_id()];
-    id_to_value_[inst->result_id()] = value;
-    return value;
+  analysis::DecorationManager* dec_mgr = context()->get_decoration_mgr();
+  const size_t mask = slots_.size() - 1;
+  for (size_t slot = hash & mask; slots_[slot] != 0; slot = (slot + 1) & mask) {
+    const uint32_t index = slots_[slot] - 1;
+    const ComputedValue& computed = computed_values_[index];
+    if (computed.result_id == 0 || computed.hash != hash ||
+        computed.num_words != key.size()) {
+      continue;
+    }
+    if (!std::equal(key.begin(), key.end(),
+                    key_words_.begin() + computed.first_word)) {
+      continue;
+    }
+    if (dec_mgr->HaveTheSameDecorations(computed.result_id, result_id)) {
+      return index;
+    }
   }
+  return kNoComputedValue;
+}
 
-  // If not, assign it a new value number.
-  value = TakeNextValueNumber();
-  id_to_value_[inst->result_id()] = value;
-  instruction_to_value_[value_ins] = value;
-  return value;
+void ValueNumberTable::AddComputedValue(const std::vector<uint32_t>& key,
+                                        size_t hash, uint32_t result_id,
+                                        uint32_t value_number) {
+  // Keep the load factor at most 1/2.
+  if (2 * (computed_values_.size() + 1) > slots_.size()) {
+    Rehash(std::max<size_t>(16, 2 * slots_.size()));
+  }
+
+  const uint32_t index = static_cast<uint32_t>(computed_values_.size());
+  computed_values_.push_back({hash, static_cast<uint32_t>(key_words_.size()),
+                              static_cast<uint32_t>(key.size()), result_id,
+                              value_number});
+  key_words_.insert(key_words_.end(), key.begin(), key.end());
+  id_to_computed_value_[result_id] = index;
+
+  const size_t mask = slots_.size() - 1;
+  size_t slot = hash & mask;
+  while (slots_[slot] != 0) slot = (slot + 1) & mask;
+  slots_[slot] = index + 1;
+}
+
+void ValueNumberTable::Rehash(size_t num_slots) {
+  slots_.assign(num_slots, 0);
+  const size_t mask = num_slots - 1;
+  for (uint32_t index = 0; index < computed_values_.size(); ++index) {
+    size_t slot = computed_values_[index].hash & mask;
+    while (slots_[slot] != 0) slot = (slot + 1) & mask;
+    slots_[slot] = index + 1;
+  }
 }
 
 void ValueNumberTable::BuildDominatorTreeValueNumberTable() {
@@ -193,48 +282,5 @@ void ValueNumberTable::BuildDominatorTreeValueNumberTable() {
   }
 }
 
-bool ComputeSameValue::operator()(const Instruction& lhs,
-                                  const Instruction& rhs) const {
-  if (lhs.result_id() == 0 || rhs.result_id() == 0) {
-    return false;
-  }
-
-  if (lhs.opcode() != rhs.opcode()) {
-    return false;
-  }
-
-  if (lhs.type_id() != rhs.type_id()) {
-    return false;
-  }
-
-  if (lhs.NumInOperands() != rhs.NumInOperands()) {
-    return false;
-  }
-
-  for (uint32_t i = 0; i < lhs.NumInOperands(); ++i) {
-    if (lhs.GetInOperand(i) != rhs.GetInOperand(i)) {
-      return false;
-    }
-  }
-
-  return lhs.context()->get_decoration_mgr()->HaveTheSameDecorations(
-      lhs.result_id(), rhs.result_id());
-}
-
-std::size_t ValueTableHash::operator()(const Instruction& inst) const {
-  // We hash the opcode and in-operands, not the result, because we want
-  // instructions that are the same except for the result to hash to the
-  // same value.
-  std::u32string h;
-  h.push_back(uint32_t(inst.opcode()));
-  h.push_back(inst.type_id());
-  for (uint32_t i = 0; i < inst.NumInOperands(); ++i) {
-    const auto& opnd = inst.GetInOperand(i);
-    for (uint32_t word : opnd.words) {
-      h.push_back(word);
-    }
-  }
-  return std::hash<std::u32string>()(h);
-}
 }  // namespace opt
 }  // namespace spvtools
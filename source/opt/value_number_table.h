@@ -17,6 +17,7 @@
 
 #include <cstdint>
 #include <unordered_map>
+#include <vector>
 
 #include "source/opt/instruction.h"
 
@@ -25,19 +26,6 @@ namespace opt {
 
 class IRContext;
 
-// Returns true if the two instructions compute the same value.  Used by the
-// value number table to compare two instructions.
-class ComputeSameValue {
- public:
-  bool operator()(const Instruction& lhs, const Instruction& rhs) const;
-};
-
-// The hash function used in the value number table.
-class ValueTableHash {
- public:
-  std::size_t operator()(const Instruction& inst) const;
-};
-
 // This class implements the value number analysis.  It is using a hash-based
 // approach to value numbering.  It is essentially doing dominator-tree value
 // numbering described in
@@ -49,6 +37,17 @@ class ValueTableHash {
 // The main difference is that because we do not perform redundancy elimination
 // as we build the value number table, we do not have to deal with cleaning up
 // the scope.
+//
+// The values computed so far are kept in an open-addressing hash table keyed
+// on the canonical form of the computation: the opcode, the result type, and
+// the in-operands with each id replaced by its value number.  The canonical
+// forms are stored back to back in a single vector, so numbering an
+// instruction never copies it.
+//
+// The table can be kept up to date as the module changes: new instructions
+// can be numbered with |AssignValueNumber|, and |RemoveInstruction| forgets
+// an instruction that is about to be deleted.  The IRContext does the latter
+// for every instruction it kills while the table is valid.
 class ValueNumberTable {
  public:
   ValueNumberTable(IRContext* ctx) : context_(ctx), next_value_number_(1) {
@@ -64,22 +63,70 @@ class ValueNumberTable {
   // has not been assigned a value number.
   uint32_t GetValueNumber(uint32_t id) const;
 
+  // Assigns a new value number to the result of |inst| if it does not already
+  // have one.  Return the value number for |inst|.  |inst| must have a result
+  // id.  The operands of |inst| should be numbered before |inst| is, or it
+  // will not be found to compute the same value as any other instruction.
+  uint32_t AssignValueNumber(Instruction* inst);
+
+  // Forgets the value number of the result of |inst|.  Must be called before
+  // |inst| is deleted, or before its result id is reused for a different
+  // computation.
+  void RemoveInstruction(Instruction* inst);
+
   IRContext* context() const { return context_; }
 
  private:
+  // A value in the table of computed values.
+  struct ComputedValue {
+    // The hash of the canonical form.
+    size_t hash;
+    // The canonical form is |key_words_[first_word, first_word + num_words)|.
+    uint32_t first_word;
+    uint32_t num_words;
+    // The result id of an instruction that computes the value, used to compare
+    // decorations.  It is 0 if that instruction was removed, in which case the
+    // value is never matched again.
+    uint32_t result_id;
+    uint32_t value_number;
+  };
+
   // Assigns a value number to every result id in the module.
   void BuildDominatorTreeValueNumberTable();
 
   // Returns the new value number.
   uint32_t TakeNextValueNumber() { return next_value_number_++; }
 
-  // Assigns a new value number to the result of |inst| if it does not already
-  // have one.  Return the value number for |inst|.  |inst| must have a result
-  // id.
-  uint32_t AssignValueNumber(Instruction* inst);
+  // Writes the canonical form of the computation done by |inst| to |key|.
+  void GetCanonicalForm(const Instruction& inst,
+                        std::vector<uint32_t>* key) const;
+
+  // Returns the index in |computed_values_| of the value that has the
+  // canonical form |key| and the same decorations as |result_id|, or
+  // |kNoComputedValue| if there is none.
+  uint32_t FindComputedValue(const std::vector<uint32_t>& key, size_t hash,
+                             uint32_t result_id) const;
+
+  // Adds a computed value with canonical form |key|, computed by |result_id|.
+  void AddComputedValue(const std::vector<uint32_t>& key, size_t hash,
+                        uint32_t result_id, uint32_t value_number);
+
+  // Resizes |slots_| to |num_slots| and reinserts every computed value.
+  void Rehash(size_t num_slots);
+
+  static constexpr uint32_t kNoComputedValue = ~0u;
+
+  // The canonical forms of all computed values.
+  std::vector<uint32_t> key_words_;
+  std::vector<ComputedValue> computed_values_;
+  // The hash table.  Each slot is 0 if empty, or 1 + an index into
+  // |computed_values_|.  The number of slots is a power of 2.
+  std::vector<uint32_t> slots_;
+  // Maps the |result_id| of each computed value to its index.
+  std::unordered_map<uint32_t, uint32_t> id_to_computed_value_;
+  // Scratch space for the canonical form of the instruction being numbered.
+  std::vector<uint32_t> scratch_key_;
 
-  std::unordered_map<Instruction, uint32_t, ValueTableHash, ComputeSameValue>
-      instruction_to_value_;
   std::unordered_map<uint32_t, uint32_t> id_to_value_;
   IRContext* context_;
   uint32_t next_value_number_;
@@ -130,3 +130,23 @@ void spvValidatorOptionsSetFriendlyNames(spv_validator_options options,
                                          bool val) {
   options->use_friendly_names = val;
 }
+
+void spvValidatorOptionsSetStructuralOnly(spv_validator_options options,
+                                          bool val) {
+  options->structural_only = val;
+}
+
+void spvValidatorOptionsSetNumThreads(spv_validator_options options,
+                                      uint32_t num_threads) {
+  options->num_threads = num_threads;
+}
+
+void spvValidatorOptionsSetCacheDirectory(spv_validator_options options,
+                                          const char* directory) {
+  options->cache_directory = directory ? directory : "";
+}
+
+void spvValidatorOptionsSetCacheSalt(spv_validator_options options,
+                                     const char* salt) {
+  options->cache_salt = salt ? salt : "";
+}
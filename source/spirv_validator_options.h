@@ -15,6 +15,9 @@
 #ifndef SOURCE_SPIRV_VALIDATOR_OPTIONS_H_
 #define SOURCE_SPIRV_VALIDATOR_OPTIONS_H_
 
+#include <ostream>
+#include <string>
+
 #include "spirv-tools/libspirv.h"
 
 // Return true if the command line option for the validator limit is valid (Also
@@ -49,7 +52,12 @@ struct spv_validator_options_t {
         skip_block_layout(false),
         allow_localsizeid(false),
         before_hlsl_legalization(false),
-        use_friendly_names(true) {}
+        use_friendly_names(true),
+        structural_only(false),
+        num_threads(1),
+        cache_directory(),
+        cache_salt(),
+        time_report_stream(nullptr) {}
 
   validator_universal_limits_t universal_limits_;
   bool relax_struct_store;
@@ -62,6 +70,14 @@ struct spv_validator_options_t {
   bool allow_localsizeid;
   bool before_hlsl_legalization;
   bool use_friendly_names;
+  bool structural_only;
+  uint32_t num_threads;
+  std::string cache_directory;
+  // Identifies the build of the tools in the keys of the validation cache.
+  std::string cache_salt;
+  // If not null, validation prints the resources used by each of its stages
+  // to this stream.
+  std::ostream* time_report_stream;
 };
 
 #endif  // SOURCE_SPIRV_VALIDATOR_OPTIONS_H_
@@ -0,0 +1,286 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SOURCE_UTIL_DENSE_ID_MAP_H_
+#define SOURCE_UTIL_DENSE_ID_MAP_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace spvtools {
+namespace utils {
+
+// A map from SPIR-V result ids to values of type |T|.
+//
+// Ids are small integers below the module's id bound, so entries are stored
+// in a vector indexed by id and a lookup is a bounds check and a load. Id 0 is
+// never a valid result id and marks an empty slot. To stay robust against
+// modules whose ids are very sparse (or whose id bound is untrusted), the
+// vector only grows while it stays within a constant factor of the number of
+// entries; ids beyond that live in a small overflow table.
+//
+// The interface mirrors the subset of std::unordered_map used for id tables.
+// Iteration visits the dense entries in increasing id order, followed by the
+// overflow entries. The key of an entry must not be modified through an
+// iterator.
+template <class T>
+class DenseIdMap {
+ public:
+  using key_type = uint32_t;
+  using mapped_type = T;
+  using value_type = std::pair<uint32_t, T>;
+  using size_type = size_t;
+
+ private:
+  template <bool IsConst>
+  class IteratorTemplate {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = typename DenseIdMap::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer =
+        typename std::conditional<IsConst, const value_type*, value_type*>::type;
+    using reference =
+        typename std::conditional<IsConst, const value_type&, value_type&>::type;
+    using MapType =
+        typename std::conditional<IsConst, const DenseIdMap, DenseIdMap>::type;
+
+    IteratorTemplate() = default;
+    IteratorTemplate(MapType* map, size_t index) : map_(map), index_(index) {
+      SkipEmpty();
+    }
+
+    // Allows conversion from an iterator to a const_iterator.
+    template <bool OtherConst,
+              typename = typename std::enable_if<IsConst && !OtherConst>::type>
+    IteratorTemplate(const IteratorTemplate<OtherConst>& other)
+        : map_(other.map_), index_(other.index_) {}
+
+    reference operator*() const { return map_->Entry(index_); }
+    pointer operator->() const { return &map_->Entry(index_); }
+
+    IteratorTemplate& operator++() {
+      ++index_;
+      SkipEmpty();
+      return *this;
+    }
+    IteratorTemplate operator++(int) {
+      IteratorTemplate tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    bool operator==(const IteratorTemplate& other) const {
+      return index_ == other.index_;
+    }
+    bool operator!=(const IteratorTemplate& other) const {
+      return !(*this == other);
+    }
+
+   private:
+    friend class DenseIdMap;
+    template <bool>
+    friend class IteratorTemplate;
+
+    void SkipEmpty() {
+      while (index_ < map_->dense_.size() && map_->dense_[index_].first == 0)
+        ++index_;
+    }
+
+    MapType* map_ = nullptr;
+    size_t index_ = 0;
+  };
+
+ public:
+  using iterator = IteratorTemplate<false>;
+  using const_iterator = IteratorTemplate<true>;
+
+  DenseIdMap() = default;
+
+  iterator begin() { return iterator(this, 0); }
+  iterator end() { return iterator(this, EndIndex()); }
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, EndIndex()); }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  size_t size() const { return num_dense_ + overflow_.size(); }
+  bool empty() const { return size() == 0; }
+
+  void clear() {
+    dense_.clear();
+    num_dense_ = 0;
+    overflow_.clear();
+    overflow_index_.clear();
+  }
+
+  // Makes room for ids below |id_bound| without further reallocation. Only
+  // use this when |id_bound| is known to be reasonable for the module.
+  void reserve(uint32_t id_bound) {
+    if (id_bound > dense_.size()) Grow(id_bound);
+  }
+
+  iterator find(uint32_t id) { return iterator(this, IndexOf(id)); }
+  const_iterator find(uint32_t id) const {
+    return const_iterator(this, IndexOf(id));
+  }
+  size_t count(uint32_t id) const { return IndexOf(id) != EndIndex() ? 1 : 0; }
+
+  // Returns the value for |id|, which must be present.
+  T& at(uint32_t id) {
+    const size_t index = IndexOf(id);
+    assert(index != EndIndex() && "id is not in the map");
+    return Entry(index).second;
+  }
+  const T& at(uint32_t id) const {
+    const size_t index = IndexOf(id);
+    assert(index != EndIndex() && "id is not in the map");
+    return Entry(index).second;
+  }
+
+  T& operator[](uint32_t id) { return insert({id, T()}).first->second; }
+
+  // Inserts |value| unless its id is already present. Returns an iterator to
+  // the entry for the id, and whether the insertion took place.
+  std::pair<iterator, bool> insert(const value_type& value) {
+    const uint32_t id = value.first;
+    assert(id != 0 && "0 is not a valid id");
+    size_t index = IndexOf(id);
+    if (index != EndIndex()) return {iterator(this, index), false};
+
+    if (id >= dense_.size() && id < DenseLimit()) {
+      Grow(std::max<size_t>(
+          static_cast<size_t>(id) + 1,
+          std::min<size_t>(2 * dense_.size(), DenseLimit())));
+    }
+    if (id < dense_.size()) {
+      dense_[id] = value;
+      ++num_dense_;
+      return {iterator(this, id), true};
+    }
+    overflow_index_[id] = overflow_.size();
+    overflow_.push_back(value);
+    return {iterator(this, dense_.size() + overflow_.size() - 1), true};
+  }
+
+  // Removes the entry for |id|, if any. Returns the number of entries removed.
+  size_t erase(uint32_t id) {
+    if (id < dense_.size()) {
+      if (dense_[id].first == 0) return 0;
+      dense_[id] = value_type();
+      --num_dense_;
+      return 1;
+    }
+    auto it = overflow_index_.find(id);
+    if (it == overflow_index_.end()) return 0;
+    const size_t index = it->second;
+    overflow_index_.erase(it);
+    if (index + 1 != overflow_.size()) {
+      overflow_[index] = std::move(overflow_.back());
+      overflow_index_[overflow_[index].first] = index;
+    }
+    overflow_.pop_back();
+    return 1;
+  }
+
+  // Removes the entry at |pos|. Iterators to other dense entries remain
+  // valid.
+  void erase(const_iterator pos) { erase(pos->first); }
+
+  // Two maps are equal if they hold the same (id, value) entries, wherever
+  // those entries are stored.
+  friend bool operator==(const DenseIdMap& lhs, const DenseIdMap& rhs) {
+    if (lhs.size() != rhs.size()) return false;
+    for (const auto& entry : lhs) {
+      auto it = rhs.find(entry.first);
+      if (it == rhs.end() || !(it->second == entry.second)) return false;
+    }
+    return true;
+  }
+  friend bool operator!=(const DenseIdMap& lhs, const DenseIdMap& rhs) {
+    return !(lhs == rhs);
+  }
+
+ private:
+  // The dense vector may grow up to this many slots per entry, plus a fixed
+  // allowance so that small modules never use the overflow table.
+  static constexpr size_t kMaxSlotsPerEntry = 8;
+  static constexpr size_t kMinDenseLimit = 4096;
+
+  size_t DenseLimit() const {
+    return std::max(kMinDenseLimit, kMaxSlotsPerEntry * (size() + 1));
+  }
+
+  size_t EndIndex() const { return dense_.size() + overflow_.size(); }
+
+  // Returns the iteration index of the entry for |id|, or EndIndex().
+  size_t IndexOf(uint32_t id) const {
+    if (id < dense_.size()) {
+      return (id != 0 && dense_[id].first == id) ? id : EndIndex();
+    }
+    auto it = overflow_index_.find(id);
+    if (it == overflow_index_.end()) return EndIndex();
+    return dense_.size() + it->second;
+  }
+
+  value_type& Entry(size_t index) {
+    return index < dense_.size() ? dense_[index]
+                                 : overflow_[index - dense_.size()];
+  }
+  const value_type& Entry(size_t index) const {
+    return index < dense_.size() ? dense_[index]
+                                 : overflow_[index - dense_.size()];
+  }
+
+  // Resizes the dense vector to |new_size| slots and moves overflow entries
+  // that now fit into it.
+  void Grow(size_t new_size) {
+    dense_.resize(new_size);
+    if (overflow_.empty()) return;
+    std::vector<value_type> remaining;
+    overflow_index_.clear();
+    for (auto& entry : overflow_) {
+      if (entry.first < dense_.size()) {
+        dense_[entry.first] = std::move(entry);
+        ++num_dense_;
+      } else {
+        overflow_index_[entry.first] = remaining.size();
+        remaining.push_back(std::move(entry));
+      }
+    }
+    overflow_ = std::move(remaining);
+  }
+
+  // Slot |id| holds the entry for |id|, or a default value_type (key 0) if
+  // there is none.
+  std::vector<value_type> dense_;
+  // The number of non-empty slots in |dense_|.
+  size_t num_dense_ = 0;
+  // Entries whose ids are too large for |dense_|, and the position of each of
+  // them in |overflow_|.
+  std::vector<value_type> overflow_;
+  std::unordered_map<uint32_t, size_t> overflow_index_;
+};
+
+}  // namespace utils
+}  // namespace spvtools
+
+#endif  // SOURCE_UTIL_DENSE_ID_MAP_H_
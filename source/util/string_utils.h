@@ -120,6 +120,22 @@ inline std::string MakeString(const uint32_t* words, size_t num_words,
   return MakeString(words, words + num_words, assert_found_terminating_null);
 }
 
+// Returns the number of characters in the string encoded in the SPIR-V words
+// from array words, scanning up to count words.  This is the length of the
+// string MakeString would decode, found without building it.  If no
+// terminating 0-byte is found, returns num_words * 4.
+inline size_t EncodedStringLength(const uint32_t* words, size_t num_words) {
+  for (size_t word_index = 0; word_index < num_words; ++word_index) {
+    const uint32_t word = words[word_index];
+    for (size_t byte_index = 0; byte_index < 4; byte_index++) {
+      if (((word >> (8 * byte_index)) & 0xFF) == 0) {
+        return word_index * 4 + byte_index;
+      }
+    }
+  }
+  return num_words * 4;
+}
+
 // Check if str starts with prefix (only included since C++20)
 inline bool starts_with(const std::string& str, const char* prefix) {
   return 0 == str.compare(0, std::strlen(prefix), prefix);
@@ -15,8 +15,10 @@
 #ifndef SOURCE_VAL_DECORATION_H_
 #define SOURCE_VAL_DECORATION_H_
 
+#include <algorithm>
 #include <cstdint>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "source/latest_version_spirv_header.h"
@@ -92,6 +94,75 @@ class Decoration {
   int struct_member_index_;
 };
 
+// The decorations applied to one <id>, without duplicates, in the order given
+// by Decoration::operator<. That is, grouped by struct member index, with the
+// decorations of the <id> itself first.
+//
+// Decorations are registered while the module is parsed and are only read
+// afterwards, so they are kept in a sorted vector rather than a node-based
+// set. A summary of the decoration types present makes the common "does this
+// <id> have decoration X" query cheap when the answer is no.
+class DecorationSet {
+ public:
+  using value_type = Decoration;
+  // Elements must stay sorted, so they cannot be modified in place.
+  using iterator = std::vector<Decoration>::const_iterator;
+  using const_iterator = std::vector<Decoration>::const_iterator;
+
+  const_iterator begin() const { return decorations_.begin(); }
+  const_iterator end() const { return decorations_.end(); }
+  size_t size() const { return decorations_.size(); }
+  bool empty() const { return decorations_.empty(); }
+
+  // Adds |dec| unless an equal decoration is present. Returns an iterator to
+  // the decoration and whether it was added.
+  std::pair<const_iterator, bool> insert(const Decoration& dec) {
+    // Decorations are usually registered in order, so check the end first.
+    auto pos = decorations_.end();
+    if (!decorations_.empty() && !(decorations_.back() < dec)) {
+      pos = std::lower_bound(decorations_.begin(), decorations_.end(), dec);
+      if (pos != decorations_.end() && *pos == dec) return {pos, false};
+    }
+    type_summary_ |= TypeBit(dec.dec_type());
+    return {decorations_.insert(pos, dec), true};
+  }
+
+  template <class InputIt>
+  void insert(InputIt first, InputIt last) {
+    for (; first != last; ++first) insert(*first);
+  }
+
+  const_iterator lower_bound(const Decoration& dec) const {
+    return std::lower_bound(decorations_.begin(), decorations_.end(), dec);
+  }
+  const_iterator upper_bound(const Decoration& dec) const {
+    return std::upper_bound(decorations_.begin(), decorations_.end(), dec);
+  }
+  const_iterator find(const Decoration& dec) const {
+    auto pos = lower_bound(dec);
+    return (pos != end() && *pos == dec) ? pos : end();
+  }
+  size_t count(const Decoration& dec) const { return find(dec) != end(); }
+
+  // Returns true if any decoration of type |type| is present, on the <id> or
+  // on one of its members.
+  bool HasDecorationType(spv::Decoration type) const {
+    if ((type_summary_ & TypeBit(type)) == 0) return false;
+    return std::any_of(
+        decorations_.begin(), decorations_.end(),
+        [type](const Decoration& d) { return d.dec_type() == type; });
+  }
+
+ private:
+  static uint64_t TypeBit(spv::Decoration type) {
+    return uint64_t(1) << (static_cast<uint32_t>(type) % 64);
+  }
+
+  std::vector<Decoration> decorations_;
+  // Bit (type % 64) is set if a decoration of that type may be present.
+  uint64_t type_summary_ = 0;
+};
+
 }  // namespace val
 }  // namespace spvtools
 
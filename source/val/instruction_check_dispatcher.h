@@ -0,0 +1,95 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SOURCE_VAL_INSTRUCTION_CHECK_DISPATCHER_H_
+#define SOURCE_VAL_INSTRUCTION_CHECK_DISPATCHER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "source/val/instruction.h"
+#include "spirv-tools/libspirv.h"
+
+namespace spvtools {
+namespace val {
+
+class ValidationState_t;
+
+// A check run on each instruction, and the opcodes it can act on. A check
+// with a null |handles| predicate is run on every instruction. A check with a
+// predicate must return SPV_SUCCESS, without side effects, for any opcode the
+// predicate rejects. |name| identifies the check in time reports.
+struct InstructionCheck {
+  spv_result_t (*check)(ValidationState_t& _, const Instruction* inst);
+  bool (*handles)(spv::Op opcode);
+  const char* name;
+};
+
+// Runs a list of instruction checks in their listed order, skipping the ones
+// that cannot act on the instruction's opcode. Which checks apply to each
+// opcode is computed once, so a pass over the instructions only calls the
+// checks relevant to each of them.
+class InstructionCheckDispatcher {
+ public:
+  // Opcodes below this value have their applicable checks precomputed. Every
+  // check is run on an instruction with a larger opcode.
+  static constexpr uint32_t kNumIndexedOpcodes = 8192;
+
+  template <size_t N>
+  explicit InstructionCheckDispatcher(const InstructionCheck (&checks)[N])
+      : checks_(checks, checks + N), masks_(kNumIndexedOpcodes, 0) {
+    static_assert(N <= 32, "one mask bit per check");
+    for (uint32_t opcode = 0; opcode < kNumIndexedOpcodes; ++opcode) {
+      for (size_t i = 0; i < N; ++i) {
+        if (!checks[i].handles ||
+            checks[i].handles(static_cast<spv::Op>(opcode))) {
+          masks_[opcode] |= uint32_t(1) << i;
+        }
+      }
+    }
+  }
+
+  // Runs the checks applicable to |inst| until one of them fails, and returns
+  // the result of the failing check, or SPV_SUCCESS. Each check is run
+  // through |report|'s Measure method.
+  template <typename Report>
+  spv_result_t Run(ValidationState_t& _, const Instruction* inst,
+                   Report* report) const {
+    const uint32_t opcode = static_cast<uint32_t>(inst->opcode());
+    // Opcodes beyond the table are rare; run every check on them.
+    uint32_t mask = opcode < kNumIndexedOpcodes ? masks_[opcode] : ~uint32_t(0);
+    for (size_t i = 0; mask != 0 && i < checks_.size(); ++i, mask >>= 1) {
+      if (mask & 1) {
+        const InstructionCheck& check = checks_[i];
+        if (auto error = report->Measure(check.name, 1, [&check, &_, inst]() {
+              return check.check(_, inst);
+            })) {
+          return error;
+        }
+      }
+    }
+    return SPV_SUCCESS;
+  }
+
+ private:
+  std::vector<InstructionCheck> checks_;
+  // Bit i of masks_[opcode] is set if checks_[i] applies to opcode.
+  std::vector<uint32_t> masks_;
+};
+
+}  // namespace val
+}  // namespace spvtools
+
+#endif  // SOURCE_VAL_INSTRUCTION_CHECK_DISPATCHER_H_
@@ -14,10 +14,20 @@
 
 #include "source/val/validate.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <ctime>
 #include <functional>
+#include <iomanip>
 #include <iterator>
 #include <memory>
+#include <mutex>
+#include <ostream>
+#include <sstream>
 #include <string>
+#include <system_error>
+#include <thread>
 #include <vector>
 
 #include "source/binary.h"
@@ -30,6 +40,8 @@
 #include "source/spirv_target_env.h"
 #include "source/val/construct.h"
 #include "source/val/instruction.h"
+#include "source/val/instruction_check_dispatcher.h"
+#include "source/val/validation_cache.h"
 #include "source/val/validation_state.h"
 #include "spirv-tools/libspirv.h"
 
@@ -151,6 +163,276 @@ spv_result_t ValidateEntryPoints(ValidationState_t& _) {
   return SPV_SUCCESS;
 }
 
+#if defined(SPIRV_TIMER_ENABLED)
+// Measures the time taken by each stage of validation and the number of
+// instructions each stage processed, and prints them when destroyed. A stage
+// run once per instruction accumulates over all of its runs, so its report
+// includes the overhead of measuring each run.
+//
+// CPU time is measured for the validating thread only, since other threads of
+// the process may be validating other modules at the same time. Work done by
+// worker threads within a stage, such as the per-function CFG checks, shows
+// in its wall time only.
+class TimeReport {
+ public:
+  explicit TimeReport(std::ostream* out) : out_(out) {}
+  TimeReport(const TimeReport&) = delete;
+  TimeReport& operator=(const TimeReport&) = delete;
+
+  ~TimeReport() {
+    if (!out_ || stages_.empty()) return;
+    // Build the whole report first, so that reports of modules validated
+    // concurrently into the same stream are not interleaved.
+    std::ostringstream report;
+    report << std::setw(40) << "Stage (instructions)" << std::setw(18)
+           << "Thread CPU time" << std::setw(12) << "WALL time" << "\n";
+    report.precision(2);
+    report << std::fixed;
+    for (auto& stage : stages_) {
+      const std::string tag = std::string(stage->name) + " (" +
+                              std::to_string(stage->instructions) + ")";
+      report << std::setw(40) << tag;
+      if (stage->failed) {
+        report << std::setw(18) << "Failed" << std::setw(12) << "Failed";
+      } else {
+        report << std::setw(18) << stage->cpu_time << std::setw(12)
+               << stage->wall_time;
+      }
+      report << "\n";
+    }
+    static std::mutex output_mutex;
+    std::lock_guard<std::mutex> lock(output_mutex);
+    *out_ << report.str() << std::flush;
+  }
+
+  // Runs |stage|, which processes |num_instructions| instructions, and
+  // accounts for it under |name|.
+  template <typename Stage>
+  spv_result_t Measure(const char* name, size_t num_instructions,
+                       Stage&& stage) {
+    if (!out_) return stage();
+    StageUsage& usage = UsageOf(name);
+    timespec cpu_before, wall_before, cpu_after, wall_after;
+    bool ok = clock_gettime(CLOCK_MONOTONIC, &wall_before) == 0 &&
+              clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu_before) == 0;
+    const spv_result_t result = stage();
+    ok = ok && clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu_after) == 0 &&
+         clock_gettime(CLOCK_MONOTONIC, &wall_after) == 0;
+    if (ok) {
+      usage.cpu_time += Seconds(cpu_before, cpu_after);
+      usage.wall_time += Seconds(wall_before, wall_after);
+    } else {
+      usage.failed = true;
+    }
+    usage.instructions += num_instructions;
+    return result;
+  }
+
+  // Accounts for |num_instructions| more instructions processed by |name|.
+  void AddInstructions(const char* name, size_t num_instructions) {
+    if (out_) UsageOf(name).instructions += num_instructions;
+  }
+
+ private:
+  struct StageUsage {
+    explicit StageUsage(const char* stage_name) : name(stage_name) {}
+
+    const char* name;
+    double cpu_time = 0;
+    double wall_time = 0;
+    // Set if a clock could not be read.
+    bool failed = false;
+    size_t instructions = 0;
+  };
+
+  static double Seconds(const timespec& from, const timespec& to) {
+    return static_cast<double>(to.tv_sec - from.tv_sec) +
+           static_cast<double>(to.tv_nsec - from.tv_nsec) * .000000001;
+  }
+
+  // Returns the usage of the stage |name|, listing it on first use.
+  StageUsage& UsageOf(const char* name) {
+    for (auto& stage : stages_) {
+      if (stage->name == name || !strcmp(stage->name, name)) return *stage;
+    }
+    stages_.emplace_back(new StageUsage(name));
+    return *stages_.back();
+  }
+
+  std::ostream* out_;
+  std::vector<std::unique_ptr<StageUsage>> stages_;
+};
+#else
+// Timers are not available: run every stage unmeasured.
+class TimeReport {
+ public:
+  explicit TimeReport(std::ostream*) {}
+
+  template <typename Stage>
+  spv_result_t Measure(const char*, size_t, Stage&& stage) {
+    return stage();
+  }
+
+  void AddInstructions(const char*, size_t) {}
+};
+#endif  // defined(SPIRV_TIMER_ENABLED)
+
+bool IsDebugPassOpcode(spv::Op opcode) {
+  return opcode == spv::Op::OpMemberName || opcode == spv::Op::OpLine;
+}
+
+bool IsAnnotationPassOpcode(spv::Op opcode) {
+  switch (opcode) {
+    case spv::Op::OpDecorate:
+    case spv::Op::OpDecorateId:
+    case spv::Op::OpMemberDecorate:
+    case spv::Op::OpDecorationGroup:
+    case spv::Op::OpGroupDecorate:
+    case spv::Op::OpGroupMemberDecorate:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool IsExtensionPassOpcode(spv::Op opcode) {
+  return opcode == spv::Op::OpExtension ||
+         opcode == spv::Op::OpExtInstImport || opcode == spv::Op::OpExtInst;
+}
+
+bool IsModeSettingPassOpcode(spv::Op opcode) {
+  switch (opcode) {
+    case spv::Op::OpEntryPoint:
+    case spv::Op::OpExecutionMode:
+    case spv::Op::OpExecutionModeId:
+    case spv::Op::OpMemoryModel:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool IsTypePassOpcode(spv::Op opcode) {
+  return spvOpcodeGeneratesType(opcode) ||
+         opcode == spv::Op::OpTypeForwardPointer;
+}
+
+bool IsConstantPassOpcode(spv::Op opcode) {
+  return spvOpcodeIsConstant(opcode);
+}
+
+bool IsFunctionPassOpcode(spv::Op opcode) {
+  return opcode == spv::Op::OpFunction ||
+         opcode == spv::Op::OpFunctionParameter ||
+         opcode == spv::Op::OpFunctionCall;
+}
+
+bool IsCompositesPassOpcode(spv::Op opcode) {
+  switch (opcode) {
+    case spv::Op::OpVectorExtractDynamic:
+    case spv::Op::OpVectorInsertDynamic:
+    case spv::Op::OpVectorShuffle:
+    case spv::Op::OpCompositeConstruct:
+    case spv::Op::OpCompositeExtract:
+    case spv::Op::OpCompositeInsert:
+    case spv::Op::OpCopyObject:
+    case spv::Op::OpTranspose:
+    case spv::Op::OpCopyLogical:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool IsControlFlowPassOpcode(spv::Op opcode) {
+  switch (opcode) {
+    case spv::Op::OpPhi:
+    case spv::Op::OpBranch:
+    case spv::Op::OpBranchConditional:
+    case spv::Op::OpReturnValue:
+    case spv::Op::OpSwitch:
+    case spv::Op::OpLoopMerge:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool IsExecutionLimitationsOpcode(spv::Op opcode) {
+  return opcode == spv::Op::OpFunction;
+}
+
+// The individual opcode checks.
+// Keep these passes in the order they appear in the SPIR-V specification
+// sections to maintain test consistency.
+const InstructionCheckDispatcher& OpcodeChecks() {
+  static const InstructionCheck kChecks[] = {
+      {MiscPass, nullptr, "MiscPass"},
+      {DebugPass, IsDebugPassOpcode, "DebugPass"},
+      {AnnotationPass, IsAnnotationPassOpcode, "AnnotationPass"},
+      {ExtensionPass, IsExtensionPassOpcode, "ExtensionPass"},
+      {ModeSettingPass, IsModeSettingPassOpcode, "ModeSettingPass"},
+      {TypePass, IsTypePassOpcode, "TypePass"},
+      {ConstantPass, IsConstantPassOpcode, "ConstantPass"},
+      {MemoryPass, nullptr, "MemoryPass"},
+      {FunctionPass, IsFunctionPassOpcode, "FunctionPass"},
+      {ImagePass, nullptr, "ImagePass"},
+      {ConversionPass, nullptr, "ConversionPass"},
+      {CompositesPass, IsCompositesPassOpcode, "CompositesPass"},
+      {ArithmeticsPass, nullptr, "ArithmeticsPass"},
+      {BitwisePass, nullptr, "BitwisePass"},
+      {LogicalsPass, nullptr, "LogicalsPass"},
+      {ControlFlowPass, IsControlFlowPassOpcode, "ControlFlowPass"},
+      {DerivativesPass, nullptr, "DerivativesPass"},
+      {AtomicsPass, nullptr, "AtomicsPass"},
+      {PrimitivesPass, nullptr, "PrimitivesPass"},
+      {BarriersPass, nullptr, "BarriersPass"},
+      // Group
+      // Device-Side Enqueue
+      // Pipe
+      {NonUniformPass, nullptr, "NonUniformPass"},
+
+      {LiteralsPass, nullptr, "LiteralsPass"},
+      {RayQueryPass, nullptr, "RayQueryPass"},
+      {RayTracingPass, nullptr, "RayTracingPass"},
+      {RayReorderNVPass, nullptr, "RayReorderNVPass"},
+      {MeshShadingPass, nullptr, "MeshShadingPass"},
+  };
+  static const InstructionCheckDispatcher dispatcher(kChecks);
+  return dispatcher;
+}
+
+// The subset of the opcode checks that validate the module's structure,
+// rather than the semantics of individual instructions. These are the only
+// opcode checks run when the structural_only option is set. The annotation
+// pass is included because it registers the decorations that the type and
+// function checks consult.
+const InstructionCheckDispatcher& StructuralOpcodeChecks() {
+  static const InstructionCheck kChecks[] = {
+      {AnnotationPass, IsAnnotationPassOpcode, "AnnotationPass"},
+      {ModeSettingPass, IsModeSettingPassOpcode, "ModeSettingPass"},
+      {TypePass, IsTypePassOpcode, "TypePass"},
+      {FunctionPass, IsFunctionPassOpcode, "FunctionPass"},
+      {ControlFlowPass, IsControlFlowPassOpcode, "ControlFlowPass"},
+  };
+  static const InstructionCheckDispatcher dispatcher(kChecks);
+  return dispatcher;
+}
+
+// Checks that must run after all of the individual opcode checks, because
+// those checks register the limitations checked here.
+const InstructionCheckDispatcher& LateChecks() {
+  static const InstructionCheck kChecks[] = {
+      {ValidateExecutionLimitations, IsExecutionLimitationsOpcode,
+       "ValidateExecutionLimitations"},
+      {ValidateSmallTypeUses, nullptr, "ValidateSmallTypeUses"},
+      {ValidateQCOMImageProcessingTextureUsages, nullptr,
+       "ValidateQCOMImageProcessingTextureUsages"},
+  };
+  static const InstructionCheckDispatcher dispatcher(kChecks);
+  return dispatcher;
+}
+
 spv_result_t ValidateBinaryUsingContextAndValidationState(
     const spv_context_t& context, const uint32_t* words, const size_t num_words,
     spv_diagnostic* pDiagnostic, ValidationState_t* vstate) {
@@ -200,13 +482,37 @@ spv_result_t ValidateBinaryUsingContextAndValidationState(
                  /* parsed_header = */ nullptr, ProcessExtensions,
                  /* diagnostic = */ nullptr);
 
+  TimeReport report(vstate->options()->time_report_stream);
+
   // Parse the module and perform inline validation checks. These checks do
   // not require the knowledge of the whole module.
-  if (auto error = spvBinaryParse(&context, vstate, words, num_words,
-                                  /*parsed_header =*/nullptr,
-                                  ProcessInstruction, pDiagnostic)) {
+  if (auto error = report.Measure("Parse", 0, [&]() {
+        return spvBinaryParse(&context, vstate, words, num_words,
+                              /*parsed_header =*/nullptr, ProcessInstruction,
+                              pDiagnostic);
+      })) {
     return error;
   }
+  const size_t num_instructions = vstate->ordered_instructions().size();
+  report.AddInstructions("Parse", num_instructions);
+
+  // Run a check of one instruction, or of the whole module, as part of the
+  // stage |name| of the time report.
+  auto instruction_check =
+      [&report, vstate](
+          const char* name,
+          spv_result_t (*check)(ValidationState_t&, const Instruction*),
+          const Instruction* inst) {
+        return report.Measure(name, 1, [check, vstate, inst]() {
+          return check(*vstate, inst);
+        });
+      };
+  auto module_check = [&report, vstate, num_instructions](
+                          const char* name,
+                          spv_result_t (*check)(ValidationState_t&)) {
+    return report.Measure(name, num_instructions,
+                          [check, vstate]() { return check(*vstate); });
+  };
 
   bool has_mask_task_nv = false;
   bool has_mask_task_ext = false;
@@ -273,13 +579,28 @@ spv_result_t ValidateBinaryUsingContextAndValidationState(
         }
       }
 
-      if (auto error = IdPass(*vstate, inst)) return error;
+      if (auto error = report.Measure("IdPass", 1, [vstate, inst]() {
+            return IdPass(*vstate, inst);
+          })) {
+        return error;
+      }
     }
 
-    if (auto error = CapabilityPass(*vstate, &instruction)) return error;
-    if (auto error = ModuleLayoutPass(*vstate, &instruction)) return error;
-    if (auto error = CfgPass(*vstate, &instruction)) return error;
-    if (auto error = InstructionPass(*vstate, &instruction)) return error;
+    if (auto error = instruction_check("CapabilityPass", CapabilityPass,
+                                       &instruction)) {
+      return error;
+    }
+    if (auto error = instruction_check("ModuleLayoutPass", ModuleLayoutPass,
+                                       &instruction)) {
+      return error;
+    }
+    if (auto error = instruction_check("CfgPass", CfgPass, &instruction)) {
+      return error;
+    }
+    if (auto error = instruction_check("InstructionPass", InstructionPass,
+                                       &instruction)) {
+      return error;
+    }
 
     // Now that all of the checks are done, update the state.
     {
@@ -311,11 +632,19 @@ spv_result_t ValidateBinaryUsingContextAndValidationState(
               "Model.";
 
   // Catch undefined forward references before performing further checks.
-  if (auto error = ValidateForwardDecls(*vstate)) return error;
+  if (auto error = report.Measure("ValidateForwardDecls", num_instructions,
+                                  [vstate]() {
+                                    return ValidateForwardDecls(*vstate);
+                                  })) {
+    return error;
+  }
 
   // Calculate reachability after all the blocks are parsed, but early that it
   // can be relied on in subsequent pases.
-  ReachabilityPass(*vstate);
+  report.Measure("ReachabilityPass", num_instructions, [vstate]() {
+    ReachabilityPass(*vstate);
+    return SPV_SUCCESS;
+  });
 
   // ID usage needs be handled in its own iteration of the instructions,
   // between the two others. It depends on the first loop to have been
@@ -325,71 +654,65 @@ spv_result_t ValidateBinaryUsingContextAndValidationState(
   // It should also live after the forward declaration check, since it will
   // have problems with missing forward declarations, but give less useful error
   // messages.
-  for (size_t i = 0; i < vstate->ordered_instructions().size(); ++i) {
-    auto& instruction = vstate->ordered_instructions()[i];
-    if (auto error = UpdateIdUse(*vstate, &instruction)) return error;
+  auto update_id_uses = [vstate]() {
+    for (const auto& instruction : vstate->ordered_instructions()) {
+      if (auto error = UpdateIdUse(*vstate, &instruction)) return error;
+    }
+    return SPV_SUCCESS;
+  };
+  if (auto error =
+          report.Measure("UpdateIdUse", num_instructions, update_id_uses)) {
+    return error;
   }
 
   // Validate individual opcodes.
+  const bool structural_only = vstate->options()->structural_only;
+  const InstructionCheckDispatcher& opcode_checks =
+      structural_only ? StructuralOpcodeChecks() : OpcodeChecks();
   for (size_t i = 0; i < vstate->ordered_instructions().size(); ++i) {
     auto& instruction = vstate->ordered_instructions()[i];
-
-    // Keep these passes in the order they appear in the SPIR-V specification
-    // sections to maintain test consistency.
-    if (auto error = MiscPass(*vstate, &instruction)) return error;
-    if (auto error = DebugPass(*vstate, &instruction)) return error;
-    if (auto error = AnnotationPass(*vstate, &instruction)) return error;
-    if (auto error = ExtensionPass(*vstate, &instruction)) return error;
-    if (auto error = ModeSettingPass(*vstate, &instruction)) return error;
-    if (auto error = TypePass(*vstate, &instruction)) return error;
-    if (auto error = ConstantPass(*vstate, &instruction)) return error;
-    if (auto error = MemoryPass(*vstate, &instruction)) return error;
-    if (auto error = FunctionPass(*vstate, &instruction)) return error;
-    if (auto error = ImagePass(*vstate, &instruction)) return error;
-    if (auto error = ConversionPass(*vstate, &instruction)) return error;
-    if (auto error = CompositesPass(*vstate, &instruction)) return error;
-    if (auto error = ArithmeticsPass(*vstate, &instruction)) return error;
-    if (auto error = BitwisePass(*vstate, &instruction)) return error;
-    if (auto error = LogicalsPass(*vstate, &instruction)) return error;
-    if (auto error = ControlFlowPass(*vstate, &instruction)) return error;
-    if (auto error = DerivativesPass(*vstate, &instruction)) return error;
-    if (auto error = AtomicsPass(*vstate, &instruction)) return error;
-    if (auto error = PrimitivesPass(*vstate, &instruction)) return error;
-    if (auto error = BarriersPass(*vstate, &instruction)) return error;
-    // Group
-    // Device-Side Enqueue
-    // Pipe
-    if (auto error = NonUniformPass(*vstate, &instruction)) return error;
-
-    if (auto error = LiteralsPass(*vstate, &instruction)) return error;
-    if (auto error = RayQueryPass(*vstate, &instruction)) return error;
-    if (auto error = RayTracingPass(*vstate, &instruction)) return error;
-    if (auto error = RayReorderNVPass(*vstate, &instruction)) return error;
-    if (auto error = MeshShadingPass(*vstate, &instruction)) return error;
+    if (auto error = opcode_checks.Run(*vstate, &instruction, &report)) {
+      return error;
+    }
   }
 
   // Validate the preconditions involving adjacent instructions. e.g.
   // spv::Op::OpPhi must only be preceded by spv::Op::OpLabel, spv::Op::OpPhi,
   // or spv::Op::OpLine.
-  if (auto error = ValidateAdjacency(*vstate)) return error;
+  if (auto error = module_check("ValidateAdjacency", ValidateAdjacency)) {
+    return error;
+  }
 
-  if (auto error = ValidateEntryPoints(*vstate)) return error;
+  if (auto error = module_check("ValidateEntryPoints", ValidateEntryPoints)) {
+    return error;
+  }
   // CFG checks are performed after the binary has been parsed
   // and the CFGPass has collected information about the control flow
-  if (auto error = PerformCfgChecks(*vstate)) return error;
-  if (auto error = CheckIdDefinitionDominateUse(*vstate)) return error;
-  if (auto error = ValidateDecorations(*vstate)) return error;
-  if (auto error = ValidateInterfaces(*vstate)) return error;
+  if (auto error = module_check("PerformCfgChecks", PerformCfgChecks)) {
+    return error;
+  }
+  if (auto error = module_check("CheckIdDefinitionDominateUse",
+                                CheckIdDefinitionDominateUse)) {
+    return error;
+  }
+  // The remaining checks are semantic ones.
+  if (structural_only) return SPV_SUCCESS;
+  if (auto error = module_check("ValidateDecorations", ValidateDecorations)) {
+    return error;
+  }
+  if (auto error = module_check("ValidateInterfaces", ValidateInterfaces)) {
+    return error;
+  }
   // TODO(dsinclair): Restructure ValidateBuiltins so we can move into the
   // for() above as it loops over all ordered_instructions internally.
-  if (auto error = ValidateBuiltIns(*vstate)) return error;
+  if (auto error = module_check("ValidateBuiltIns", ValidateBuiltIns)) {
+    return error;
+  }
   // These checks must be performed after individual opcode checks because
   // those checks register the limitation checked here.
+  const InstructionCheckDispatcher& late_checks = LateChecks();
   for (const auto& inst : vstate->ordered_instructions()) {
-    if (auto error = ValidateExecutionLimitations(*vstate, &inst)) return error;
-    if (auto error = ValidateSmallTypeUses(*vstate, &inst)) return error;
-    if (auto error = ValidateQCOMImageProcessingTextureUsages(*vstate, &inst))
-      return error;
+    if (auto error = late_checks.Run(*vstate, &inst, &report)) return error;
   }
 
   return SPV_SUCCESS;
@@ -459,11 +782,140 @@ spv_result_t spvValidateWithOptions(const spv_const_context context,
     spvtools::UseDiagnosticAsMessageConsumer(&hijack_context, pDiagnostic);
   }
 
+  // With a cache, replay the outcome of an earlier validation of the same
+  // binary and settings, or record this one while passing messages through.
+  // A time report asks for the validation to actually run.
+  const std::string& cache_directory = options->cache_directory;
+  std::string cache_key;
+  if (!cache_directory.empty() && !options->time_report_stream &&
+      spvtools::val::ValidationCacheEnabled(*options)) {
+    cache_key = spvtools::val::ValidationCacheKey(
+        context->target_env, *options, binary->code, binary->wordCount);
+  }
+  const bool use_cache = !cache_key.empty();
+  std::string cache_entry;
+  spvtools::val::CachedValidation outcome;
+  if (use_cache) {
+    cache_entry = spvtools::val::ValidationCacheEntryName(cache_key);
+    if (spvtools::val::LoadValidationCacheEntry(cache_directory, cache_entry,
+                                                cache_key, &outcome)) {
+      if (hijack_context.consumer) {
+        for (const auto& message : outcome.messages) {
+          hijack_context.consumer(message.level, message.source.c_str(),
+                                  message.position, message.message.c_str());
+        }
+      }
+      return outcome.result;
+    }
+    spvtools::MessageConsumer consumer = std::move(hijack_context.consumer);
+    hijack_context.consumer = [consumer, &outcome](
+                                  spv_message_level_t level, const char* source,
+                                  const spv_position_t& position,
+                                  const char* message) {
+      outcome.messages.push_back({level, source ? source : "", position,
+                                  message ? message : ""});
+      if (consumer) consumer(level, source, position, message);
+    };
+  }
+
   // Create the ValidationState using the context.
   spvtools::val::ValidationState_t vstate(&hijack_context, options,
                                           binary->code, binary->wordCount,
                                           kDefaultMaxNumOfWarnings);
 
-  return spvtools::val::ValidateBinaryUsingContextAndValidationState(
-      hijack_context, binary->code, binary->wordCount, pDiagnostic, &vstate);
+  // The parser would report its errors straight into |pDiagnostic|, past the
+  // recording consumer. The hijacked consumer fills |pDiagnostic| anyway.
+  const spv_result_t result =
+      spvtools::val::ValidateBinaryUsingContextAndValidationState(
+          hijack_context, binary->code, binary->wordCount,
+          use_cache ? nullptr : pDiagnostic, &vstate);
+
+  // Running out of memory or hitting an internal error says nothing about the
+  // module, so such outcomes are not worth keeping.
+  if (use_cache && result != SPV_ERROR_OUT_OF_MEMORY &&
+      result != SPV_ERROR_INTERNAL) {
+    outcome.result = result;
+    spvtools::val::StoreValidationCacheEntry(cache_directory, cache_entry,
+                                             cache_key, outcome);
+  }
+  return result;
+}
+
+spv_result_t spvValidateBinaries(const spv_const_context context,
+                                 spv_const_validator_options options,
+                                 const spv_const_binary_t* binaries,
+                                 size_t num_binaries, uint32_t num_threads,
+                                 spv_result_t* results,
+                                 spv_diagnostic* pDiagnostics) {
+  if (num_binaries == 0) return SPV_SUCCESS;
+  if (!binaries || !results) return SPV_ERROR_INVALID_POINTER;
+
+  // Without diagnostics, each module's messages are kept with their level and
+  // sent to the context's consumer once all workers are done, in module order
+  // and prefixed with the index of the module.
+  struct ModuleMessage {
+    spv_message_level_t level;
+    std::string source;
+    spv_position_t position;
+    std::string message;
+  };
+  const bool collect_messages = !pDiagnostics && context->consumer;
+  std::vector<std::vector<ModuleMessage>> messages(
+      collect_messages ? num_binaries : 0);
+
+  // Each worker claims the next unvalidated module until none are left, so
+  // a few large modules do not leave the other workers idle.
+  std::atomic<size_t> next_binary(0);
+  const auto validate_next_binaries = [&]() {
+    spv_context_t module_context = *context;
+    for (size_t i = next_binary++; i < num_binaries; i = next_binary++) {
+      if (collect_messages) {
+        std::vector<ModuleMessage>* module_messages = &messages[i];
+        module_context.consumer =
+            [module_messages](spv_message_level_t level, const char* source,
+                              const spv_position_t& position,
+                              const char* message) {
+              module_messages->push_back({level, source ? source : "",
+                                          position, message ? message : ""});
+            };
+      }
+      results[i] = spvValidateWithOptions(
+          &module_context, options, &binaries[i],
+          pDiagnostics ? &pDiagnostics[i] : nullptr);
+    }
+  };
+
+  if (num_threads == 0) {
+    num_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  const size_t num_workers = std::min<size_t>(num_threads, num_binaries);
+  std::vector<std::thread> workers;
+  workers.reserve(num_workers - 1);
+  for (size_t i = 1; i < num_workers; ++i) {
+    // If no more threads can be started, the workers that are running share
+    // the remaining modules.  Exceptions must not escape through the C API.
+    try {
+      workers.emplace_back(validate_next_binaries);
+    } catch (const std::system_error&) {
+      break;
+    }
+  }
+  // The calling thread does its share of the work as well.
+  validate_next_binaries();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  for (size_t i = 0; i < messages.size(); ++i) {
+    const std::string prefix = "module " + std::to_string(i) + ": ";
+    for (const auto& m : messages[i]) {
+      context->consumer(m.level, m.source.empty() ? nullptr : m.source.c_str(),
+                        m.position, (prefix + m.message).c_str());
+    }
+  }
+
+  for (size_t i = 0; i < num_binaries; ++i) {
+    if (results[i] != SPV_SUCCESS) return results[i];
+  }
+  return SPV_SUCCESS;
 }
@@ -12,11 +12,14 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <functional>
 #include <iostream>
 #include <map>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <unordered_map>
 #include <unordered_set>
@@ -966,128 +969,215 @@ spv_result_t MaximalReconvergenceChecks(ValidationState_t& _) {
   return SPV_SUCCESS;
 }
 
-spv_result_t PerformCfgChecks(ValidationState_t& _) {
-  for (auto& function : _.functions()) {
-    // Check all referenced blocks are defined within a function
-    if (function.undefined_block_count() != 0) {
-      std::string undef_blocks("{");
-      bool first = true;
-      for (auto undefined_block : function.undefined_blocks()) {
-        undef_blocks += _.getIdName(undefined_block);
-        if (!first) {
-          undef_blocks += " ";
+// Performs the control flow checks that only involve |function|. This reads
+// but does not modify the module-wide validation state, so it may run
+// concurrently for different functions.
+spv_result_t PerformFunctionCfgChecks(ValidationState_t& _,
+                                      Function* function) {
+  // Check all referenced blocks are defined within a function
+  if (function->undefined_block_count() != 0) {
+    std::string undef_blocks("{");
+    bool first = true;
+    for (auto undefined_block : function->undefined_blocks()) {
+      undef_blocks += _.getIdName(undefined_block);
+      if (!first) {
+        undef_blocks += " ";
+      }
+      first = false;
+    }
+    return _.diag(SPV_ERROR_INVALID_CFG, _.FindDef(function->id()))
+           << "Block(s) " << undef_blocks << "}"
+           << " are referenced but not defined in function "
+           << _.getIdName(function->id());
+  }
+
+  // Set each block's immediate dominator.
+  //
+  // We want to analyze all the blocks in the function, even in degenerate
+  // control flow cases including unreachable blocks.  So use the augmented
+  // CFG to ensure we cover all the blocks.
+  std::vector<const BasicBlock*> postorder;
+  auto ignore_block = [](const BasicBlock*) {};
+  auto no_terminal_blocks = [](const BasicBlock*) { return false; };
+  if (!function->ordered_blocks().empty()) {
+    /// calculate dominators
+    CFA<BasicBlock>::DepthFirstTraversal(
+        function->first_block(), function->AugmentedCFGSuccessorsFunction(),
+        ignore_block, [&](const BasicBlock* b) { postorder.push_back(b); },
+        no_terminal_blocks);
+    auto edges = CFA<BasicBlock>::CalculateDominators(
+        postorder, function->AugmentedCFGPredecessorsFunction());
+    for (auto edge : edges) {
+      if (edge.first != edge.second)
+        edge.first->SetImmediateDominator(edge.second);
+    }
+  }
+
+  auto& blocks = function->ordered_blocks();
+  if (!blocks.empty()) {
+    // Check if the order of blocks in the binary appear before the blocks
+    // they dominate
+    for (auto block = begin(blocks) + 1; block != end(blocks); ++block) {
+      if (auto idom = (*block)->immediate_dominator()) {
+        if (idom != function->pseudo_entry_block() &&
+            block == std::find(begin(blocks), block, idom)) {
+          return _.diag(SPV_ERROR_INVALID_CFG, _.FindDef(idom->id()))
+                 << "Block " << _.getIdName((*block)->id())
+                 << " appears in the binary before its dominator "
+                 << _.getIdName(idom->id());
         }
-        first = false;
       }
-      return _.diag(SPV_ERROR_INVALID_CFG, _.FindDef(function.id()))
-             << "Block(s) " << undef_blocks << "}"
-             << " are referenced but not defined in function "
-             << _.getIdName(function.id());
     }
+    // If we have structured control flow, check that no block has a control
+    // flow nesting depth larger than the limit.
+    if (_.HasCapability(spv::Capability::Shader)) {
+      const int control_flow_nesting_depth_limit =
+          _.options()->universal_limits_.max_control_flow_nesting_depth;
+      for (auto block = begin(blocks); block != end(blocks); ++block) {
+        if (function->GetBlockDepth(*block) >
+            control_flow_nesting_depth_limit) {
+          return _.diag(SPV_ERROR_INVALID_CFG, _.FindDef((*block)->id()))
+                 << "Maximum Control Flow nesting depth exceeded.";
+        }
+      }
+    }
+  }
 
-    // Set each block's immediate dominator.
-    //
-    // We want to analyze all the blocks in the function, even in degenerate
-    // control flow cases including unreachable blocks.  So use the augmented
-    // CFG to ensure we cover all the blocks.
-    std::vector<const BasicBlock*> postorder;
-    auto ignore_block = [](const BasicBlock*) {};
-    auto no_terminal_blocks = [](const BasicBlock*) { return false; };
-    if (!function.ordered_blocks().empty()) {
+  /// Structured control flow checks are only required for shader capabilities
+  if (_.HasCapability(spv::Capability::Shader)) {
+    // Calculate structural dominance.
+    postorder.clear();
+    std::vector<const BasicBlock*> postdom_postorder;
+    std::vector<std::pair<uint32_t, uint32_t>> back_edges;
+    if (!function->ordered_blocks().empty()) {
       /// calculate dominators
       CFA<BasicBlock>::DepthFirstTraversal(
-          function.first_block(), function.AugmentedCFGSuccessorsFunction(),
-          ignore_block, [&](const BasicBlock* b) { postorder.push_back(b); },
+          function->first_block(),
+          function->AugmentedStructuralCFGSuccessorsFunction(), ignore_block,
+          [&](const BasicBlock* b) { postorder.push_back(b); },
           no_terminal_blocks);
       auto edges = CFA<BasicBlock>::CalculateDominators(
-          postorder, function.AugmentedCFGPredecessorsFunction());
+          postorder, function->AugmentedStructuralCFGPredecessorsFunction());
       for (auto edge : edges) {
         if (edge.first != edge.second)
-          edge.first->SetImmediateDominator(edge.second);
+          edge.first->SetImmediateStructuralDominator(edge.second);
       }
-    }
 
-    auto& blocks = function.ordered_blocks();
-    if (!blocks.empty()) {
-      // Check if the order of blocks in the binary appear before the blocks
-      // they dominate
-      for (auto block = begin(blocks) + 1; block != end(blocks); ++block) {
-        if (auto idom = (*block)->immediate_dominator()) {
-          if (idom != function.pseudo_entry_block() &&
-              block == std::find(begin(blocks), block, idom)) {
-            return _.diag(SPV_ERROR_INVALID_CFG, _.FindDef(idom->id()))
-                   << "Block " << _.getIdName((*block)->id())
-                   << " appears in the binary before its dominator "
-                   << _.getIdName(idom->id());
-          }
-        }
+      /// calculate post dominators
+      CFA<BasicBlock>::DepthFirstTraversal(
+          function->pseudo_exit_block(),
+          function->AugmentedStructuralCFGPredecessorsFunction(), ignore_block,
+          [&](const BasicBlock* b) { postdom_postorder.push_back(b); },
+          no_terminal_blocks);
+      auto postdom_edges = CFA<BasicBlock>::CalculateDominators(
+          postdom_postorder,
+          function->AugmentedStructuralCFGSuccessorsFunction());
+      for (auto edge : postdom_edges) {
+        edge.first->SetImmediateStructuralPostDominator(edge.second);
       }
-      // If we have structured control flow, check that no block has a control
-      // flow nesting depth larger than the limit.
-      if (_.HasCapability(spv::Capability::Shader)) {
-        const int control_flow_nesting_depth_limit =
-            _.options()->universal_limits_.max_control_flow_nesting_depth;
-        for (auto block = begin(blocks); block != end(blocks); ++block) {
-          if (function.GetBlockDepth(*block) >
-              control_flow_nesting_depth_limit) {
-            return _.diag(SPV_ERROR_INVALID_CFG, _.FindDef((*block)->id()))
-                   << "Maximum Control Flow nesting depth exceeded.";
-          }
+      /// calculate back edges.
+      CFA<BasicBlock>::DepthFirstTraversal(
+          function->pseudo_entry_block(),
+          function->AugmentedStructuralCFGSuccessorsFunction(), ignore_block,
+          ignore_block,
+          [&](const BasicBlock* from, const BasicBlock* to) {
+            // A back edge must be a real edge. Since the augmented successors
+            // contain structural edges, filter those from consideration.
+            for (const auto* succ : *(from->successors())) {
+              if (succ == to) back_edges.emplace_back(from->id(), to->id());
+            }
+          },
+          no_terminal_blocks);
+    }
+    UpdateContinueConstructExitBlocks(*function, back_edges);
+
+    if (auto error =
+            StructuredControlFlowChecks(_, function, back_edges, postorder))
+      return error;
+  }
+
+  return SPV_SUCCESS;
+}
+
+// Runs PerformFunctionCfgChecks on every function using up to |num_threads|
+// threads. Diagnostics are collected per function and then reported in
+// module order, up to and including those of the first failing function, so
+// the results match a serial run.
+spv_result_t PerformFunctionCfgChecksInParallel(ValidationState_t& _,
+                                                size_t num_threads) {
+  struct Message {
+    spv_message_level_t level;
+    std::string source;
+    spv_position_t position;
+    std::string text;
+  };
+
+  auto& functions = _.functions();
+  const size_t num_functions = functions.size();
+  std::vector<spv_result_t> results(num_functions, SPV_SUCCESS);
+  std::vector<std::vector<Message>> messages(num_functions);
+
+  // Each worker claims the next unchecked function. Functions after the first
+  // known failure cannot affect the outcome, so they are skipped.
+  std::atomic<size_t> next_function(0);
+  std::atomic<size_t> first_failure(num_functions);
+  const auto check_next_functions = [&]() {
+    for (size_t i = next_function++; i < num_functions; i = next_function++) {
+      if (i > first_failure.load()) continue;
+      auto& function_messages = messages[i];
+      const MessageConsumer collect =
+          [&function_messages](spv_message_level_t level, const char* source,
+                               const spv_position_t& position,
+                               const char* message) {
+            function_messages.push_back(
+                {level, source ? source : "", position, message});
+          };
+      ValidationState_t::ScopedDiagnosticConsumer scoped_consumer(collect);
+      results[i] = PerformFunctionCfgChecks(_, &functions[i]);
+      if (results[i] != SPV_SUCCESS) {
+        size_t failure = first_failure.load();
+        while (i < failure && !first_failure.compare_exchange_weak(failure, i)) {
         }
       }
     }
+  };
 
-    /// Structured control flow checks are only required for shader capabilities
-    if (_.HasCapability(spv::Capability::Shader)) {
-      // Calculate structural dominance.
-      postorder.clear();
-      std::vector<const BasicBlock*> postdom_postorder;
-      std::vector<std::pair<uint32_t, uint32_t>> back_edges;
-      if (!function.ordered_blocks().empty()) {
-        /// calculate dominators
-        CFA<BasicBlock>::DepthFirstTraversal(
-            function.first_block(),
-            function.AugmentedStructuralCFGSuccessorsFunction(), ignore_block,
-            [&](const BasicBlock* b) { postorder.push_back(b); },
-            no_terminal_blocks);
-        auto edges = CFA<BasicBlock>::CalculateDominators(
-            postorder, function.AugmentedStructuralCFGPredecessorsFunction());
-        for (auto edge : edges) {
-          if (edge.first != edge.second)
-            edge.first->SetImmediateStructuralDominator(edge.second);
-        }
+  const size_t num_workers = std::min(num_threads, num_functions);
+  std::vector<std::thread> workers;
+  workers.reserve(num_workers - 1);
+  for (size_t i = 1; i < num_workers; ++i) {
+    workers.emplace_back(check_next_functions);
+  }
+  // The calling thread does its share of the work as well.
+  check_next_functions();
+  for (auto& worker : workers) {
+    worker.join();
+  }
 
-        /// calculate post dominators
-        CFA<BasicBlock>::DepthFirstTraversal(
-            function.pseudo_exit_block(),
-            function.AugmentedStructuralCFGPredecessorsFunction(), ignore_block,
-            [&](const BasicBlock* b) { postdom_postorder.push_back(b); },
-            no_terminal_blocks);
-        auto postdom_edges = CFA<BasicBlock>::CalculateDominators(
-            postdom_postorder,
-            function.AugmentedStructuralCFGSuccessorsFunction());
-        for (auto edge : postdom_edges) {
-          edge.first->SetImmediateStructuralPostDominator(edge.second);
-        }
-        /// calculate back edges.
-        CFA<BasicBlock>::DepthFirstTraversal(
-            function.pseudo_entry_block(),
-            function.AugmentedStructuralCFGSuccessorsFunction(), ignore_block,
-            ignore_block,
-            [&](const BasicBlock* from, const BasicBlock* to) {
-              // A back edge must be a real edge. Since the augmented successors
-              // contain structural edges, filter those from consideration.
-              for (const auto* succ : *(from->successors())) {
-                if (succ == to) back_edges.emplace_back(from->id(), to->id());
-              }
-            },
-            no_terminal_blocks);
+  const MessageConsumer& consumer = _.context()->consumer;
+  for (size_t i = 0; i < num_functions; ++i) {
+    if (consumer) {
+      for (const auto& message : messages[i]) {
+        consumer(message.level, message.source.c_str(), message.position,
+                 message.text.c_str());
       }
-      UpdateContinueConstructExitBlocks(function, back_edges);
+    }
+    if (results[i] != SPV_SUCCESS) return results[i];
+  }
+  return SPV_SUCCESS;
+}
 
-      if (auto error =
-              StructuredControlFlowChecks(_, &function, back_edges, postorder))
-        return error;
+spv_result_t PerformCfgChecks(ValidationState_t& _) {
+  size_t num_threads = _.options()->num_threads;
+  if (num_threads == 0) {
+    num_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  if (num_threads > 1 && _.functions().size() > 1) {
+    if (auto error = PerformFunctionCfgChecksInParallel(_, num_threads))
+      return error;
+  } else {
+    for (auto& function : _.functions()) {
+      if (auto error = PerformFunctionCfgChecks(_, &function)) return error;
     }
   }
 
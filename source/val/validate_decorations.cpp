@@ -172,6 +172,38 @@ uint32_t align(uint32_t x, uint32_t alignment) {
   return (x + alignment - 1) & ~(alignment - 1);
 }
 
+// The layout computations memoized in ValidationState_t::layout_cache().
+// Member constraints are always derived from the decorations of the enclosing
+// structs, so a result depends only on the type and its inherited layout.
+enum LayoutComputation : uint32_t {
+  kBaseAlignment,
+  kExtendedAlignment,
+  kScalarAlignment,
+  kSize,
+};
+
+// Returns the cached result of |computation| for |type_id| under |inherited|,
+// calling |compute| to produce it on the first request.
+template <typename Compute>
+uint32_t getCachedLayout(LayoutComputation computation, uint32_t type_id,
+                         const LayoutConstraints& inherited,
+                         ValidationState_t& vstate, Compute compute) {
+  const ValidationState_t::LayoutCacheKey key{
+      computation, type_id, inherited.matrix_stride,
+      inherited.majorness == kRowMajor};
+  auto& cache = vstate.layout_cache();
+  const auto iter = cache.find(key);
+  if (iter != cache.end()) return iter->second;
+  const uint32_t result = compute();
+  cache.emplace(key, result);
+  return result;
+}
+
+uint32_t computeBaseAlignment(uint32_t member_id, bool roundUp,
+                              const LayoutConstraints& inherited,
+                              MemberConstraints& constraints,
+                              ValidationState_t& vstate);
+
 // Returns base alignment of struct member. If |roundUp| is true, also
 // ensure that structs, arrays, and matrices are aligned at least to a
 // multiple of 16 bytes.  (That is, when roundUp is true, this function
@@ -180,6 +212,18 @@ uint32_t getBaseAlignment(uint32_t member_id, bool roundUp,
                           const LayoutConstraints& inherited,
                           MemberConstraints& constraints,
                           ValidationState_t& vstate) {
+  return getCachedLayout(
+      roundUp ? kExtendedAlignment : kBaseAlignment, member_id, inherited,
+      vstate, [&]() {
+        return computeBaseAlignment(member_id, roundUp, inherited, constraints,
+                                    vstate);
+      });
+}
+
+uint32_t computeBaseAlignment(uint32_t member_id, bool roundUp,
+                              const LayoutConstraints& inherited,
+                              MemberConstraints& constraints,
+                              ValidationState_t& vstate) {
   const auto inst = vstate.FindDef(member_id);
   const auto& words = inst->words();
   // Minimal alignment is byte-aligned.
@@ -254,8 +298,17 @@ uint32_t getBaseAlignment(uint32_t member_id, bool roundUp,
   return baseAlignment;
 }
 
+uint32_t computeScalarAlignment(uint32_t type_id, ValidationState_t& vstate);
+
 // Returns scalar alignment of a type.
 uint32_t getScalarAlignment(uint32_t type_id, ValidationState_t& vstate) {
+  return getCachedLayout(kScalarAlignment, type_id, LayoutConstraints(),
+                         vstate, [&]() {
+                           return computeScalarAlignment(type_id, vstate);
+                         });
+}
+
+uint32_t computeScalarAlignment(uint32_t type_id, ValidationState_t& vstate) {
   const auto inst = vstate.FindDef(type_id);
   const auto& words = inst->words();
   switch (inst->opcode()) {
@@ -299,10 +352,20 @@ uint32_t getScalarAlignment(uint32_t type_id, ValidationState_t& vstate) {
   return 1;
 }
 
+uint32_t computeSize(uint32_t member_id, const LayoutConstraints& inherited,
+                     MemberConstraints& constraints, ValidationState_t& vstate);
+
 // Returns size of a struct member. Doesn't include padding at the end of struct
 // or array.  Assumes that in the struct case, all members have offsets.
 uint32_t getSize(uint32_t member_id, const LayoutConstraints& inherited,
                  MemberConstraints& constraints, ValidationState_t& vstate) {
+  return getCachedLayout(kSize, member_id, inherited, vstate, [&]() {
+    return computeSize(member_id, inherited, constraints, vstate);
+  });
+}
+
+uint32_t computeSize(uint32_t member_id, const LayoutConstraints& inherited,
+                     MemberConstraints& constraints, ValidationState_t& vstate) {
   const auto inst = vstate.FindDef(member_id);
   const auto& words = inst->words();
   switch (inst->opcode()) {
@@ -1065,7 +1128,7 @@ spv_result_t CheckDecorationsOfBuffers(ValidationState_t& vstate) {
         // Vulkan: There must be no more than one PushConstant block per entry
         // point.
         if (push_constant) {
-          auto entry_points = vstate.EntryPointReferences(var_id);
+          const auto& entry_points = vstate.EntryPointReferences(var_id);
           for (auto ep_id : entry_points) {
             const bool already_used = !uses_push_constant.insert(ep_id).second;
             if (already_used) {
@@ -1081,7 +1144,7 @@ spv_result_t CheckDecorationsOfBuffers(ValidationState_t& vstate) {
         // Vulkan: Check DescriptorSet and Binding decoration for
         // UniformConstant which cannot be a struct.
         if (uniform_constant) {
-          auto entry_points = vstate.EntryPointReferences(var_id);
+          const auto& entry_points = vstate.EntryPointReferences(var_id);
           if (!entry_points.empty() &&
               !hasDecoration(var_id, spv::Decoration::DescriptorSet, vstate)) {
             return vstate.diag(SPV_ERROR_INVALID_ID, vstate.FindDef(var_id))
@@ -1109,7 +1172,7 @@ spv_result_t CheckDecorationsOfBuffers(ValidationState_t& vstate) {
             hasDecoration(var_id, spv::Decoration::BufferBlock, vstate);
         if ((uniform && (has_block || has_buffer_block)) ||
             (storage_buffer && has_block)) {
-          auto entry_points = vstate.EntryPointReferences(var_id);
+          const auto& entry_points = vstate.EntryPointReferences(var_id);
           if (!entry_points.empty() &&
               !hasDecoration(var_id, spv::Decoration::Binding, vstate)) {
             return vstate.diag(SPV_ERROR_INVALID_ID, vstate.FindDef(var_id))
@@ -1191,7 +1254,7 @@ spv_result_t CheckDecorationsOfBuffers(ValidationState_t& vstate) {
           // Vulkan: Check DescriptorSet and Binding decoration for
           // Uniform and StorageBuffer variables.
           if (uniform || storage_buffer) {
-            auto entry_points = vstate.EntryPointReferences(var_id);
+            const auto& entry_points = vstate.EntryPointReferences(var_id);
             if (!entry_points.empty() &&
                 !hasDecoration(var_id, spv::Decoration::DescriptorSet,
                                vstate)) {
@@ -1312,6 +1375,10 @@ spv_result_t CheckDecorationsOfBuffers(ValidationState_t& vstate) {
       if (data_type_inst->opcode() == spv::Op::OpTypeStruct) {
         ComputeMemberConstraintsForStruct(&constraints, data_type_id,
                                           LayoutConstraints(), vstate);
+      } else if (data_type_inst->opcode() == spv::Op::OpTypeArray ||
+                 data_type_inst->opcode() == spv::Op::OpTypeRuntimeArray) {
+        ComputeMemberConstraintsForArray(&constraints, data_type_id,
+                                         LayoutConstraints(), vstate);
       }
       if (auto res = checkLayout(data_type_id, "PhysicalStorageBuffer", "Block",
                                  !buffer, scalar_block_layout, 0, constraints,
@@ -35,8 +35,7 @@ bool HaveLayoutCompatibleMembers(ValidationState_t&, const Instruction*,
                                  const Instruction*);
 bool HaveSameLayoutDecorations(ValidationState_t&, const Instruction*,
                                const Instruction*);
-bool HasConflictingMemberOffsets(const std::set<Decoration>&,
-                                 const std::set<Decoration>&);
+bool HasConflictingMemberOffsets(const DecorationSet&, const DecorationSet&);
 
 bool IsAllowedTypeOrArrayOfSame(ValidationState_t& _, const Instruction* type,
                                 std::initializer_list<spv::Op> allowed) {
@@ -105,8 +104,8 @@ bool HaveSameLayoutDecorations(ValidationState_t& _, const Instruction* type1,
          "type1 must be an OpTypeStruct instruction.");
   assert(type2->opcode() == spv::Op::OpTypeStruct &&
          "type2 must be an OpTypeStruct instruction.");
-  const std::set<Decoration>& type1_decorations = _.id_decorations(type1->id());
-  const std::set<Decoration>& type2_decorations = _.id_decorations(type2->id());
+  const DecorationSet& type1_decorations = _.id_decorations(type1->id());
+  const DecorationSet& type2_decorations = _.id_decorations(type2->id());
 
   // TODO: Will have to add other check for arrays an matricies if we want to
   // handle them.
@@ -118,8 +117,8 @@ bool HaveSameLayoutDecorations(ValidationState_t& _, const Instruction* type1,
 }
 
 bool HasConflictingMemberOffsets(
-    const std::set<Decoration>& type1_decorations,
-    const std::set<Decoration>& type2_decorations) {
+    const DecorationSet& type1_decorations,
+    const DecorationSet& type2_decorations) {
   {
     // We are interested in conflicting decoration.  If a decoration is in one
     // list but not the other, then we will assume the code is correct.  We are
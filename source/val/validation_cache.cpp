@@ -0,0 +1,327 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "source/val/validation_cache.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "source/latest_version_spirv_header.h"
+
+namespace spvtools {
+namespace val {
+namespace {
+
+// The first line of every cache entry is this header, then the size of the
+// rest of the entry. Bump the number whenever the layout of an entry changes.
+const char kEntryHeader[] = "spirv-val cache 2 ";
+
+// Keys of larger modules are not cached, which bounds the size of an entry.
+const size_t kMaxKeySize = 4 << 20;
+// Bounds the space taken by the diagnostics of one entry.
+const size_t kMaxMessagesSize = 1 << 20;
+// The number of distinct entry names, and so of entries in a cache.
+const uint32_t kNumEntryNames = 1024;
+
+bool IsDevelopmentVersion() {
+  const std::string version = spvSoftwareVersionString();
+  const std::string suffix = "-dev";
+  return version.size() >= suffix.size() &&
+         version.compare(version.size() - suffix.size(), suffix.size(),
+                         suffix) == 0;
+}
+
+// Returns the 64-bit FNV-1a hash of |size| bytes at |data|. The hash must be
+// stable across runs and platforms, so std::hash can't be used.
+uint64_t Fnv1a(const void* data, size_t size) {
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (size_t i = 0; i < size; ++i) {
+    hash = (hash ^ bytes[i]) * 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+// Appends |value| to |key| as |num_bytes| little-endian bytes, so keys are
+// the same on every platform.
+void AppendWord(uint64_t value, size_t num_bytes, std::string* key) {
+  for (size_t i = 0; i < num_bytes; ++i) {
+    key->push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+  }
+}
+
+void AppendString(const char* str, std::string* key) {
+  const size_t size = std::strlen(str);
+  AppendWord(size, 8, key);
+  key->append(str, size);
+}
+
+std::string EntryPath(const std::string& directory, const std::string& name) {
+  std::string path = directory;
+  if (!path.empty() && path.back() != '/' && path.back() != '\\') {
+    path += '/';
+  }
+  return path + name + ".spvval";
+}
+
+// Reads a decimal integer followed by |separator| from |data| at |*pos|.
+bool ReadNumber(const std::string& data, size_t* pos, char separator,
+                long long* value) {
+  size_t i = *pos;
+  const bool negative = i < data.size() && data[i] == '-';
+  if (negative) ++i;
+  const size_t first_digit = i;
+  unsigned long long magnitude = 0;
+  while (i < data.size() && data[i] >= '0' && data[i] <= '9') {
+    magnitude = 10 * magnitude + static_cast<unsigned>(data[i] - '0');
+    ++i;
+  }
+  if (i == first_digit || i - first_digit > 18 || i >= data.size() ||
+      data[i] != separator) {
+    return false;
+  }
+  *value = negative ? -static_cast<long long>(magnitude)
+                    : static_cast<long long>(magnitude);
+  *pos = i + 1;
+  return true;
+}
+
+bool ReadBytes(const std::string& data, size_t* pos, long long size,
+               std::string* bytes) {
+  if (size < 0 || static_cast<unsigned long long>(size) > data.size() - *pos) {
+    return false;
+  }
+  bytes->assign(data, *pos, static_cast<size_t>(size));
+  *pos += static_cast<size_t>(size);
+  return true;
+}
+
+// Parses |data| as an entry holding the outcome for |key|.
+bool ParseEntry(const std::string& data, const std::string& key,
+                CachedValidation* entry) {
+  const size_t header_size = sizeof(kEntryHeader) - 1;
+  if (data.compare(0, header_size, kEntryHeader) != 0) return false;
+  size_t pos = header_size;
+
+  // A truncated or extended entry is rejected before anything else is read.
+  long long body_size = 0;
+  if (!ReadNumber(data, &pos, '\n', &body_size) || body_size < 0 ||
+      static_cast<unsigned long long>(body_size) != data.size() - pos) {
+    return false;
+  }
+
+  // Entries are named by a hash of their key, so an entry found under the
+  // expected name may still belong to another key.
+  long long key_size = 0;
+  if (!ReadNumber(data, &pos, '\n', &key_size) ||
+      static_cast<unsigned long long>(key_size) != key.size() ||
+      key.size() >= data.size() - pos ||
+      data.compare(pos, key.size(), key) != 0 ||
+      data[pos + key.size()] != '\n') {
+    return false;
+  }
+  pos += key.size() + 1;
+
+  long long result = 0;
+  long long num_messages = 0;
+  if (!ReadNumber(data, &pos, ' ', &result) ||
+      !ReadNumber(data, &pos, '\n', &num_messages) || num_messages < 0) {
+    return false;
+  }
+  entry->result = static_cast<spv_result_t>(result);
+  entry->messages.clear();
+  for (long long i = 0; i < num_messages; ++i) {
+    long long level = 0, line = 0, column = 0, index = 0;
+    long long source_size = 0, message_size = 0;
+    CachedMessage message;
+    if (!ReadNumber(data, &pos, ' ', &level) ||
+        !ReadNumber(data, &pos, ' ', &line) ||
+        !ReadNumber(data, &pos, ' ', &column) ||
+        !ReadNumber(data, &pos, ' ', &index) ||
+        !ReadNumber(data, &pos, ' ', &source_size) ||
+        !ReadNumber(data, &pos, '\n', &message_size) ||
+        !ReadBytes(data, &pos, source_size, &message.source) ||
+        !ReadBytes(data, &pos, message_size, &message.message) ||
+        pos >= data.size() || data[pos++] != '\n') {
+      return false;
+    }
+    if (level < SPV_MSG_FATAL || level > SPV_MSG_DEBUG || line < 0 ||
+        column < 0 || index < 0) {
+      return false;
+    }
+    message.level = static_cast<spv_message_level_t>(level);
+    message.position.line = static_cast<size_t>(line);
+    message.position.column = static_cast<size_t>(column);
+    message.position.index = static_cast<size_t>(index);
+    entry->messages.push_back(std::move(message));
+  }
+  return pos == data.size();
+}
+
+std::string SerializeEntry(const std::string& key,
+                           const CachedValidation& entry) {
+  std::string body = std::to_string(key.size()) + '\n';
+  body += key;
+  body += '\n';
+  body += std::to_string(static_cast<int>(entry.result)) + ' ' +
+          std::to_string(entry.messages.size()) + '\n';
+  for (const auto& message : entry.messages) {
+    body += std::to_string(static_cast<int>(message.level)) + ' ' +
+            std::to_string(message.position.line) + ' ' +
+            std::to_string(message.position.column) + ' ' +
+            std::to_string(message.position.index) + ' ' +
+            std::to_string(message.source.size()) + ' ' +
+            std::to_string(message.message.size()) + '\n';
+    body += message.source;
+    body += message.message;
+    body += '\n';
+  }
+  return kEntryHeader + std::to_string(body.size()) + '\n' + body;
+}
+
+// The largest entry that is written or read.
+size_t MaxEntrySize() {
+  return sizeof(kEntryHeader) + 64 + kMaxKeySize + kMaxMessagesSize;
+}
+
+// Returns a file name suffix that no other writer uses at the same time.
+std::string UniqueSuffix() {
+  static std::atomic<uint64_t> counter{0};
+  std::string seed;
+  AppendWord(counter++, 8, &seed);
+  AppendWord(std::hash<std::thread::id>()(std::this_thread::get_id()), 8,
+             &seed);
+  AppendWord(static_cast<uint64_t>(
+                 std::chrono::steady_clock::now().time_since_epoch().count()),
+             8, &seed);
+  char suffix[17];
+  std::snprintf(suffix, sizeof(suffix), "%016llx",
+                static_cast<unsigned long long>(Fnv1a(seed.data(),
+                                                      seed.size())));
+  return suffix;
+}
+
+}  // namespace
+
+bool ValidationCacheEnabled(const spv_validator_options_t& options) {
+  return !options.cache_salt.empty() || !IsDevelopmentVersion();
+}
+
+std::string ValidationCacheKey(spv_target_env env,
+                               const spv_validator_options_t& options,
+                               const uint32_t* words, size_t num_words) {
+  if (num_words > kMaxKeySize / sizeof(uint32_t)) return "";
+
+  std::string key;
+  AppendString(spvSoftwareVersionDetailsString(), &key);
+  AppendWord(spv::Version, 4, &key);
+  AppendWord(spv::Revision, 4, &key);
+  AppendString(options.cache_salt.c_str(), &key);
+  AppendWord(static_cast<uint64_t>(env), 8, &key);
+
+  // Every option that can change the outcome. The number of threads and the
+  // cache directory itself do not.
+  const validator_universal_limits_t& limits = options.universal_limits_;
+  for (uint32_t limit :
+       {limits.max_struct_members, limits.max_struct_depth,
+        limits.max_local_variables, limits.max_global_variables,
+        limits.max_switch_branches, limits.max_function_args,
+        limits.max_control_flow_nesting_depth,
+        limits.max_access_chain_indexes, limits.max_id_bound}) {
+    AppendWord(limit, 4, &key);
+  }
+  for (bool flag :
+       {options.relax_struct_store, options.relax_logical_pointer,
+        options.relax_block_layout, options.uniform_buffer_standard_layout,
+        options.scalar_block_layout, options.workgroup_scalar_block_layout,
+        options.skip_block_layout, options.allow_localsizeid,
+        options.before_hlsl_legalization, options.use_friendly_names,
+        options.structural_only}) {
+    AppendWord(flag ? 1 : 0, 1, &key);
+  }
+
+  AppendWord(num_words, 8, &key);
+  const size_t header_size = key.size();
+  if (header_size + num_words * sizeof(uint32_t) > kMaxKeySize) return "";
+  key.reserve(header_size + num_words * sizeof(uint32_t));
+  for (size_t i = 0; i < num_words; ++i) AppendWord(words[i], 4, &key);
+  return key;
+}
+
+std::string ValidationCacheEntryName(const std::string& key) {
+  char name[16];
+  std::snprintf(name, sizeof(name), "%04x",
+                static_cast<unsigned>(Fnv1a(key.data(), key.size()) %
+                                      kNumEntryNames));
+  return name;
+}
+
+bool LoadValidationCacheEntry(const std::string& directory,
+                              const std::string& name, const std::string& key,
+                              CachedValidation* entry) {
+  FILE* file = std::fopen(EntryPath(directory, name).c_str(), "rb");
+  if (!file) return false;
+  // Entries are never written larger than MaxEntrySize, so stop reading past
+  // it rather than load an arbitrarily large file.
+  const size_t max_size = MaxEntrySize();
+  std::string data;
+  char buffer[4096];
+  size_t count = 0;
+  while (data.size() <= max_size &&
+         (count = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+    data.append(buffer, count);
+  }
+  const bool read_ok = !std::ferror(file) && data.size() <= max_size;
+  std::fclose(file);
+  return read_ok && ParseEntry(data, key, entry);
+}
+
+void StoreValidationCacheEntry(const std::string& directory,
+                               const std::string& name, const std::string& key,
+                               const CachedValidation& entry) {
+  if (key.empty()) return;
+  const std::string data = SerializeEntry(key, entry);
+  if (data.size() > MaxEntrySize()) return;
+
+  const std::string path = EntryPath(directory, name);
+  const std::string temp_path = path + "." + UniqueSuffix() + ".tmp";
+  FILE* file = std::fopen(temp_path.c_str(), "wb");
+  if (!file) return;
+  const bool write_ok =
+      std::fwrite(data.data(), 1, data.size(), file) == data.size();
+  const bool close_ok = std::fclose(file) == 0;
+  if (!write_ok || !close_ok) {
+    std::remove(temp_path.c_str());
+    return;
+  }
+  // Renaming over an existing file fails on some platforms, so evict the
+  // previous entry and try again. Losing a race with another writer leaves
+  // its entry in place, and the temporary file must not be left behind.
+  if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+    std::remove(path.c_str());
+    if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+      std::remove(temp_path.c_str());
+    }
+  }
+}
+
+}  // namespace val
+}  // namespace spvtools
@@ -0,0 +1,87 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SOURCE_VAL_VALIDATION_CACHE_H_
+#define SOURCE_VAL_VALIDATION_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "source/spirv_validator_options.h"
+#include "spirv-tools/libspirv.h"
+
+namespace spvtools {
+namespace val {
+
+// A message reported to the message consumer while validating a module.
+struct CachedMessage {
+  spv_message_level_t level;
+  std::string source;
+  spv_position_t position;
+  std::string message;
+};
+
+// The outcome of validating a module: the returned status and the messages
+// reported along the way, in the order they were reported.
+struct CachedValidation {
+  spv_result_t result = SPV_SUCCESS;
+  std::vector<CachedMessage> messages;
+};
+
+// Returns true if a validation cache can be used with |options|. An entry
+// must only be reused by the build that wrote it. The version of a release
+// identifies its build, but a development version is shared by every build
+// made between two releases, whatever their local changes. Those builds use
+// the cache only if the caller identifies the build with a cache salt.
+bool ValidationCacheEnabled(const spv_validator_options_t& options);
+
+// Returns the key identifying the validation of the |num_words| words at
+// |words| for |env| with |options|: the version of the tools and of the
+// SPIR-V headers they were built with, the cache salt, the target
+// environment, every option that can change the outcome of validation, and
+// the binary itself. Two validations have the same outcome if they have
+// the same key. Returns an empty string if the module is too large to cache.
+std::string ValidationCacheKey(spv_target_env env,
+                               const spv_validator_options_t& options,
+                               const uint32_t* words, size_t num_words);
+
+// Returns the name of the cache entry that holds the outcome for |key|. Keys
+// are spread over a fixed number of names, which bounds the number of entries
+// in a cache directory. Keys sharing a name evict each other.
+std::string ValidationCacheEntryName(const std::string& key);
+
+// Reads the entry |name| from the cache in |directory| into |entry|. Returns
+// false if there is no such entry, if it can't be read, if it is malformed,
+// truncated or written in another format, or if it holds the outcome for a
+// key other than |key|.
+bool LoadValidationCacheEntry(const std::string& directory,
+                              const std::string& name, const std::string& key,
+                              CachedValidation* entry);
+
+// Writes |entry| for |key| as the entry |name| in the cache in |directory|,
+// which must already exist, replacing any previous entry of that name. The
+// entry is written to a temporary file that is then renamed into place, so
+// that concurrent readers never see a partial entry. Entries that would be
+// too large are not written. Failures are ignored, since the cache only ever
+// saves work.
+void StoreValidationCacheEntry(const std::string& directory,
+                               const std::string& name, const std::string& key,
+                               const CachedValidation& entry);
+
+}  // namespace val
+}  // namespace spvtools
+
+#endif  // SOURCE_VAL_VALIDATION_CACHE_H_
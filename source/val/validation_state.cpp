@@ -21,6 +21,7 @@
 #include "source/opcode.h"
 #include "source/spirv_constant.h"
 #include "source/spirv_target_env.h"
+#include "source/util/bit_vector.h"
 #include "source/util/make_unique.h"
 #include "source/val/basic_block.h"
 #include "source/val/construct.h"
@@ -210,18 +211,17 @@ ValidationState_t::ValidationState_t(const spv_const_context ctx,
     preallocateStorage();
   }
   UpdateFeaturesBasedOnSpirvVersion(&features_, version_);
-
-  name_mapper_ = spvtools::GetTrivialNameMapper();
-  if (options_->use_friendly_names) {
-    friendly_mapper_ = spvtools::MakeUnique<spvtools::FriendlyNameMapper>(
-        context_, words_, num_words_);
-    name_mapper_ = friendly_mapper_->GetNameMapper();
-  }
 }
 
 void ValidationState_t::preallocateStorage() {
   ordered_instructions_.reserve(total_instructions_);
   module_functions_.reserve(total_functions_);
+  // Each instruction defines at most one id, so this bounds the table even
+  // when the header's id bound is unreasonably large.
+  all_definitions_.reserve(static_cast<uint32_t>(
+      std::min<size_t>(id_bound_, total_instructions_ + 1)));
+  id_decorations_.reserve(static_cast<uint32_t>(
+      std::min<size_t>(id_bound_, total_instructions_ + 1)));
 }
 
 spv_result_t ValidationState_t::ForwardDeclareId(uint32_t id) {
@@ -248,7 +248,9 @@ void ValidationState_t::AssignNameToId(uint32_t id, std::string name) {
 }
 
 std::string ValidationState_t::getIdName(uint32_t id) const {
-  const std::string id_name = name_mapper_(id);
+  const std::string id_name = options_->use_friendly_names
+                                  ? friendly_name_mapper()(id)
+                                  : std::to_string(id);
 
   std::stringstream out;
   out << "'" << id << "[%" << id_name << "]'";
@@ -303,11 +305,32 @@ bool ValidationState_t::IsOpcodeInCurrentLayoutSection(spv::Op op) {
   return IsInstructionInLayoutSection(current_layout_section_, op);
 }
 
+namespace {
+
+// The consumer installed by the innermost live ScopedDiagnosticConsumer on
+// this thread, if any.
+thread_local const MessageConsumer* diagnostic_consumer_override = nullptr;
+
+}  // namespace
+
+ValidationState_t::ScopedDiagnosticConsumer::ScopedDiagnosticConsumer(
+    const MessageConsumer& consumer)
+    : previous_(diagnostic_consumer_override) {
+  diagnostic_consumer_override = &consumer;
+}
+
+ValidationState_t::ScopedDiagnosticConsumer::~ScopedDiagnosticConsumer() {
+  diagnostic_consumer_override = previous_;
+}
+
 DiagnosticStream ValidationState_t::diag(spv_result_t error_code,
                                          const Instruction* inst) {
+  const MessageConsumer& consumer = diagnostic_consumer_override
+                                        ? *diagnostic_consumer_override
+                                        : context_->consumer;
   if (error_code == SPV_WARNING) {
     if (num_of_warnings_ == max_num_of_warnings_) {
-      DiagnosticStream({0, 0, 0}, context_->consumer, "", error_code)
+      DiagnosticStream({0, 0, 0}, consumer, "", error_code)
           << "Other warnings have been suppressed.\n";
     }
     if (num_of_warnings_ >= max_num_of_warnings_) {
@@ -319,8 +342,8 @@ DiagnosticStream ValidationState_t::diag(spv_result_t error_code,
   std::string disassembly;
   if (inst) disassembly = Disassemble(*inst);
 
-  return DiagnosticStream({0, 0, inst ? inst->LineNum() : 0},
-                          context_->consumer, disassembly, error_code);
+  return DiagnosticStream({0, 0, inst ? inst->LineNum() : 0}, consumer,
+                          disassembly, error_code);
 }
 
 std::vector<Function>& ValidationState_t::functions() {
@@ -829,23 +852,47 @@ uint32_t ValidationState_t::getIdBound() const { return id_bound_; }
 
 void ValidationState_t::setIdBound(const uint32_t bound) { id_bound_ = bound; }
 
-bool ValidationState_t::RegisterUniqueTypeDeclaration(const Instruction* inst) {
-  std::vector<uint32_t> key;
-  key.push_back(static_cast<uint32_t>(inst->opcode()));
-  for (size_t index = 0; index < inst->operands().size(); ++index) {
-    const spv_parsed_operand_t& operand = inst->operand(index);
+namespace {
 
-    if (operand.type == SPV_OPERAND_TYPE_RESULT_ID) continue;
+// Returns the index of the word holding the result id of |inst|, or the
+// number of words if it has none.
+size_t ResultIdWordIndex(const Instruction* inst) {
+  for (const auto& operand : inst->operands()) {
+    if (operand.type == SPV_OPERAND_TYPE_RESULT_ID) return operand.offset;
+  }
+  return inst->words().size();
+}
 
-    const int words_begin = operand.offset;
-    const int words_end = words_begin + operand.num_words;
-    assert(words_end <= static_cast<int>(inst->words().size()));
+}  // namespace
 
-    key.insert(key.end(), inst->words().begin() + words_begin,
-               inst->words().begin() + words_end);
+size_t ValidationState_t::TypeDeclarationHash::operator()(
+    const Instruction* inst) const {
+  const auto& words = inst->words();
+  const size_t result_index = ResultIdWordIndex(inst);
+  size_t hash = 0;
+  for (size_t i = 0; i < words.size(); ++i) {
+    if (i != result_index) hash = utils::hash_combine(hash, words[i]);
+  }
+  return hash;
+}
+
+bool ValidationState_t::TypeDeclarationEqual::operator()(
+    const Instruction* lhs, const Instruction* rhs) const {
+  // Word 0 encodes the opcode and word count, so comparing every word but
+  // the result id compares the opcode and all other operands.
+  const auto& lhs_words = lhs->words();
+  const auto& rhs_words = rhs->words();
+  if (lhs_words.size() != rhs_words.size()) return false;
+  const size_t result_index = ResultIdWordIndex(lhs);
+  if (result_index != ResultIdWordIndex(rhs)) return false;
+  for (size_t i = 0; i < lhs_words.size(); ++i) {
+    if (i != result_index && lhs_words[i] != rhs_words[i]) return false;
   }
+  return true;
+}
 
-  return unique_type_declarations_.insert(std::move(key)).second;
+bool ValidationState_t::RegisterUniqueTypeDeclaration(const Instruction* inst) {
+  return unique_type_declarations_.insert(inst).second;
 }
 
 uint32_t ValidationState_t::GetTypeId(uint32_t id) const {
@@ -1439,6 +1486,77 @@ void ValidationState_t::ComputeFunctionToEntryPointMapping() {
       }
     }
   }
+
+  ComputeEntryPointReferences();
+}
+
+void ValidationState_t::ComputeEntryPointReferences() {
+  std::vector<uint32_t> sorted_entry_points = entry_points();
+  std::sort(sorted_entry_points.begin(), sorted_entry_points.end());
+  sorted_entry_points.erase(
+      std::unique(sorted_entry_points.begin(), sorted_entry_points.end()),
+      sorted_entry_points.end());
+  const uint32_t num_bits =
+      std::max<uint32_t>(1, static_cast<uint32_t>(sorted_entry_points.size()));
+  const auto to_ids = [&sorted_entry_points](const utils::BitVector& bits) {
+    std::vector<uint32_t> ids;
+    for (uint32_t i = 0; i < sorted_entry_points.size(); ++i) {
+      if (bits.Get(i)) ids.push_back(sorted_entry_points[i]);
+    }
+    return ids;
+  };
+
+  // Bit i of an entry point set stands for sorted_entry_points[i].
+  std::unordered_map<uint32_t, utils::BitVector> function_bits;
+  for (const auto& pair : function_to_entry_points_) {
+    utils::BitVector bits(num_bits);
+    for (const uint32_t entry_point : pair.second) {
+      const auto iter = std::lower_bound(sorted_entry_points.begin(),
+                                         sorted_entry_points.end(),
+                                         entry_point);
+      bits.Set(static_cast<uint32_t>(iter - sorted_entry_points.begin()));
+    }
+    function_entry_point_references_[pair.first] = to_ids(bits);
+    function_bits.emplace(pair.first, std::move(bits));
+  }
+
+  // A global instruction is referenced by the entry points of the functions
+  // that use it, and by those referencing the global instructions that use
+  // it. Uses between global instructions can form cycles, for example through
+  // forward pointers, so the sets are grown until they no longer change. Most
+  // uses come later in the module, so visiting the globals in reverse order
+  // converges in one or two rounds.
+  std::vector<const Instruction*> globals;
+  std::unordered_map<uint32_t, utils::BitVector> global_bits;
+  for (const auto& inst : ordered_instructions()) {
+    if (inst.function() == nullptr && inst.id() != 0) {
+      globals.push_back(&inst);
+      global_bits.emplace(inst.id(), utils::BitVector(num_bits));
+    }
+  }
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (auto it = globals.rbegin(); it != globals.rend(); ++it) {
+      utils::BitVector& bits = global_bits.at((*it)->id());
+      for (const auto& use : (*it)->uses()) {
+        const Instruction* user = use.first;
+        if (const Function* func = user->function()) {
+          const auto func_iter = function_bits.find(func->id());
+          if (func_iter != function_bits.end()) {
+            changed |= bits.Or(func_iter->second);
+          }
+        } else if (user->id() != 0) {
+          changed |= bits.Or(global_bits.at(user->id()));
+        }
+      }
+    }
+  }
+
+  for (const auto& pair : global_bits) {
+    std::vector<uint32_t> ids = to_ids(pair.second);
+    if (!ids.empty()) entry_point_references_[pair.first] = std::move(ids);
+  }
 }
 
 void ValidationState_t::ComputeRecursiveEntryPoints() {
@@ -1484,37 +1602,38 @@ const std::vector<uint32_t>& ValidationState_t::FunctionEntryPoints(
   }
 }
 
-std::set<uint32_t> ValidationState_t::EntryPointReferences(uint32_t id) const {
-  std::set<uint32_t> referenced_entry_points;
+const std::vector<uint32_t>& ValidationState_t::EntryPointReferences(
+    uint32_t id) const {
   const auto inst = FindDef(id);
-  if (!inst) return referenced_entry_points;
-
-  std::vector<const Instruction*> stack;
-  stack.push_back(inst);
-  while (!stack.empty()) {
-    const auto current_inst = stack.back();
-    stack.pop_back();
-
-    if (const auto func = current_inst->function()) {
-      // Instruction lives in a function, we can stop searching.
-      const auto function_entry_points = FunctionEntryPoints(func->id());
-      referenced_entry_points.insert(function_entry_points.begin(),
-                                     function_entry_points.end());
-    } else {
-      // Instruction is in the global scope, keep searching its uses.
-      for (auto pair : current_inst->uses()) {
-        const auto next_inst = pair.first;
-        stack.push_back(next_inst);
-      }
-    }
-  }
+  if (!inst) return empty_ids_;
+
+  // An instruction in a function is referenced by the entry points that can
+  // call the function.
+  const auto& references = inst->function() ? function_entry_point_references_
+                                            : entry_point_references_;
+  const uint32_t key = inst->function() ? inst->function()->id() : id;
+  const auto iter = references.find(key);
+  return iter == references.end() ? empty_ids_ : iter->second;
+}
 
-  return referenced_entry_points;
+const NameMapper& ValidationState_t::friendly_name_mapper() const {
+  // Diagnostics may be emitted concurrently by checks running on worker
+  // threads, so the mapper is built exactly once.
+  std::call_once(friendly_mapper_once_, [this]() {
+    friendly_mapper_ = spvtools::MakeUnique<spvtools::FriendlyNameMapper>(
+        context_, words_, num_words_);
+    friendly_name_mapper_ = friendly_mapper_->GetNameMapper();
+  });
+  return friendly_name_mapper_;
 }
 
 std::string ValidationState_t::Disassemble(const Instruction& inst) const {
-  const spv_parsed_instruction_t& c_inst(inst.c_inst());
-  return Disassemble(c_inst.words, c_inst.num_words);
+  // The instruction is already parsed, so it can be disassembled on its own
+  // with the module's cached friendly names.
+  return spvInstructionBinaryToText(
+      grammar_, inst.c_inst(), friendly_name_mapper(),
+      SPV_BINARY_TO_TEXT_OPTION_NO_HEADER |
+          SPV_BINARY_TO_TEXT_OPTION_FRIENDLY_NAMES);
 }
 
 std::string ValidationState_t::Disassemble(const uint32_t* words,
@@ -17,6 +17,8 @@
 
 #include <algorithm>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <tuple>
@@ -32,6 +34,8 @@
 #include "source/name_mapper.h"
 #include "source/spirv_definition.h"
 #include "source/spirv_validator_options.h"
+#include "source/util/dense_id_map.h"
+#include "source/util/hash_combine.h"
 #include "source/val/decoration.h"
 #include "source/val/function.h"
 #include "source/val/instruction.h"
@@ -151,6 +155,10 @@ class ValidationState_t {
   /// the OpName instruction
   std::string getIdName(uint32_t id) const;
 
+  /// Returns a name mapper giving the friendly name of each id in the module.
+  /// The mapping is computed on the first call and shared by later ones.
+  const NameMapper& friendly_name_mapper() const;
+
   /// Accessor function for ID bound.
   uint32_t getIdBound() const;
 
@@ -192,6 +200,23 @@ class ValidationState_t {
 
   DiagnosticStream diag(spv_result_t error_code, const Instruction* inst);
 
+  /// While an instance is alive, diagnostics emitted by diag() on the
+  /// creating thread are sent to |consumer| instead of the context's message
+  /// consumer. This lets checks that run on worker threads collect their
+  /// messages so they can be reported in a deterministic order.
+  class ScopedDiagnosticConsumer {
+   public:
+    explicit ScopedDiagnosticConsumer(const MessageConsumer& consumer);
+    ~ScopedDiagnosticConsumer();
+
+    ScopedDiagnosticConsumer(const ScopedDiagnosticConsumer&) = delete;
+    ScopedDiagnosticConsumer& operator=(const ScopedDiagnosticConsumer&) =
+        delete;
+
+   private:
+    const MessageConsumer* previous_;
+  };
+
   /// Returns the function states
   std::vector<Function>& functions();
 
@@ -269,7 +294,9 @@ class ValidationState_t {
     return &it->second;
   }
 
-  /// Traverses call tree and computes function_to_entry_points_.
+  /// Traverses call tree and computes function_to_entry_points_, then the
+  /// index of the entry points referencing each id used by
+  /// EntryPointReferences.
   /// Note: called after fully parsing the binary.
   void ComputeFunctionToEntryPointMapping();
 
@@ -281,10 +308,39 @@ class ValidationState_t {
   /// Returns all the entry points that can call |func|.
   const std::vector<uint32_t>& FunctionEntryPoints(uint32_t func) const;
 
-  /// Returns all the entry points that statically use |id|.
+  /// Identifies a size or alignment computed during block layout validation:
+  /// the kind of computation, the type, and the layout the type inherits.
+  struct LayoutCacheKey {
+    uint32_t kind;
+    uint32_t type_id;
+    uint32_t matrix_stride;
+    bool row_major;
+
+    bool operator==(const LayoutCacheKey& other) const {
+      return kind == other.kind && type_id == other.type_id &&
+             matrix_stride == other.matrix_stride &&
+             row_major == other.row_major;
+    }
+  };
+  struct LayoutCacheKeyHash {
+    size_t operator()(const LayoutCacheKey& key) const {
+      return utils::hash_combine(0, key.kind, key.type_id, key.matrix_stride,
+                                 key.row_major);
+    }
+  };
+  using LayoutCache =
+      std::unordered_map<LayoutCacheKey, uint32_t, LayoutCacheKeyHash>;
+
+  /// Returns the sizes and alignments computed so far by block layout
+  /// validation. These depend only on the module, so each is computed once
+  /// per validation run however many blocks share a type.
+  LayoutCache& layout_cache() { return layout_cache_; }
+
+  /// Returns all the entry points that statically use |id|, in increasing id
+  /// order.
   ///
   /// Note: requires ComputeFunctionToEntryPointMapping to have been called.
-  std::set<uint32_t> EntryPointReferences(uint32_t id) const;
+  const std::vector<uint32_t>& EntryPointReferences(uint32_t id) const;
 
   /// Inserts an <id> to the set of functions that are target of OpFunctionCall.
   void AddFunctionCallTarget(const uint32_t id) {
@@ -391,14 +447,18 @@ class ValidationState_t {
   /// Registers the decoration for the given <id>
   void RegisterDecorationForId(uint32_t id, const Decoration& dec) {
     auto& dec_list = id_decorations_[id];
-    dec_list.insert(dec);
+    if (dec_list.insert(dec).second &&
+        dec.dec_type() == spv::Decoration::BuiltIn) {
+      RegisterBuiltInDecoratedId(id);
+    }
   }
 
   /// Registers the list of decorations for the given <id>
   template <class InputIt>
   void RegisterDecorationsForId(uint32_t id, InputIt begin, InputIt end) {
-    std::set<Decoration>& cur_decs = id_decorations_[id];
-    cur_decs.insert(begin, end);
+    for (InputIt iter = begin; iter != end; ++iter) {
+      RegisterDecorationForId(id, *iter);
+    }
   }
 
   /// Registers the list of decorations for the given member of the given
@@ -407,29 +467,30 @@ class ValidationState_t {
   void RegisterDecorationsForStructMember(uint32_t struct_id,
                                           uint32_t member_index, InputIt begin,
                                           InputIt end) {
-    std::set<Decoration>& cur_decs = id_decorations_[struct_id];
     for (InputIt iter = begin; iter != end; ++iter) {
       Decoration dec = *iter;
       dec.set_struct_member_index(member_index);
-      cur_decs.insert(dec);
+      RegisterDecorationForId(struct_id, dec);
     }
   }
 
-  /// Returns all the decorations for the given <id>. If no decorations exist
-  /// for the <id>, it registers an empty set for it in the map and
-  /// returns the empty set.
-  std::set<Decoration>& id_decorations(uint32_t id) {
-    return id_decorations_[id];
+  /// Returns all the decorations for the given <id>, or an empty set if
+  /// there are none. The reference is invalidated by registering further
+  /// decorations.
+  const DecorationSet& id_decorations(uint32_t id) const {
+    static const DecorationSet kNoDecorations;
+    const auto it = id_decorations_.find(id);
+    return it == id_decorations_.end() ? kNoDecorations : it->second;
   }
 
   /// Returns the range of decorations for the given field of the given <id>.
   struct FieldDecorationsIter {
-    std::set<Decoration>::const_iterator begin;
-    std::set<Decoration>::const_iterator end;
+    DecorationSet::const_iterator begin;
+    DecorationSet::const_iterator end;
   };
   FieldDecorationsIter id_member_decorations(uint32_t id,
-                                             uint32_t member_index) {
-    const auto& decorations = id_decorations_[id];
+                                             uint32_t member_index) const {
+    const auto& decorations = id_decorations(id);
 
     // The decorations are sorted by member_index, so this look up will give the
     // exact range of decorations for this member index.
@@ -444,19 +505,20 @@ class ValidationState_t {
   }
 
   // Returns const pointer to the internal decoration container.
-  const std::map<uint32_t, std::set<Decoration>>& id_decorations() const {
+  const utils::DenseIdMap<DecorationSet>& id_decorations() const {
     return id_decorations_;
   }
 
+  /// Returns the <id>s that have a BuiltIn decoration, on the <id> itself or
+  /// on a member, in increasing order.
+  const std::vector<uint32_t>& builtin_decorated_ids() const {
+    return builtin_decorated_ids_;
+  }
+
   /// Returns true if the given id <id> has the given decoration <dec>,
   /// otherwise returns false.
-  bool HasDecoration(uint32_t id, spv::Decoration dec) {
-    const auto& decorations = id_decorations_.find(id);
-    if (decorations == id_decorations_.end()) return false;
-
-    return std::any_of(
-        decorations->second.begin(), decorations->second.end(),
-        [dec](const Decoration& d) { return dec == d.dec_type(); });
+  bool HasDecoration(uint32_t id, spv::Decoration dec) const {
+    return id_decorations(id).HasDecorationType(dec);
   }
 
   /// Finds id's def, if it exists.  If found, returns the definition otherwise
@@ -473,7 +535,7 @@ class ValidationState_t {
   }
 
   /// Returns a map of instructions mapped by their result id
-  const std::unordered_map<uint32_t, Instruction*>& all_definitions() const {
+  const utils::DenseIdMap<Instruction*>& all_definitions() const {
     return all_definitions_;
   }
 
@@ -561,7 +623,8 @@ class ValidationState_t {
   // Returns the state of optional features.
   const Feature& features() const { return features_; }
 
-  /// Adds the instruction data to unique_type_declarations_.
+  /// Adds the instruction to unique_type_declarations_. |inst| must remain
+  /// valid for the lifetime of this object.
   /// Returns false if an identical type declaration already exists.
   bool RegisterUniqueTypeDeclaration(const Instruction* inst);
 
@@ -814,6 +877,19 @@ class ValidationState_t {
  private:
   ValidationState_t(const ValidationState_t&);
 
+  /// Computes function_entry_point_references_ and entry_point_references_
+  /// from function_to_entry_points_.
+  void ComputeEntryPointReferences();
+
+  /// Adds |id| to builtin_decorated_ids_, keeping it sorted.
+  void RegisterBuiltInDecoratedId(uint32_t id) {
+    auto pos = std::lower_bound(builtin_decorated_ids_.begin(),
+                                builtin_decorated_ids_.end(), id);
+    if (pos == builtin_decorated_ids_.end() || *pos != id) {
+      builtin_decorated_ids_.insert(pos, id);
+    }
+  }
+
   const spv_const_context context_;
 
   /// Stores the Validator command line options. Must be a valid options object.
@@ -870,7 +946,7 @@ class ValidationState_t {
   std::vector<Instruction> ordered_instructions_;
 
   /// Instructions that can be referenced by Ids
-  std::unordered_map<uint32_t, Instruction*> all_definitions_;
+  utils::DenseIdMap<Instruction*> all_definitions_;
 
   /// IDs that are entry points, ie, arguments to OpEntryPoint.
   std::vector<uint32_t> entry_points_;
@@ -906,13 +982,26 @@ class ValidationState_t {
       struct_has_nested_blockorbufferblock_struct_;
 
   /// Stores the list of decorations for a given <id>
-  std::map<uint32_t, std::set<Decoration>> id_decorations_;
+  utils::DenseIdMap<DecorationSet> id_decorations_;
 
-  /// Stores type declarations which need to be unique (i.e. non-aggregates),
-  /// in the form [opcode, operand words], result_id is not stored.
-  /// Using ordered set to avoid the need for a vector hash function.
-  /// The size of this container is expected not to exceed double-digits.
-  std::set<std::vector<uint32_t>> unique_type_declarations_;
+  /// Sorted <id>s that have a BuiltIn decoration. See builtin_decorated_ids().
+  std::vector<uint32_t> builtin_decorated_ids_;
+
+  /// Hashes and compares type declarations by their opcode and operand
+  /// words, ignoring the result id.
+  struct TypeDeclarationHash {
+    size_t operator()(const Instruction* inst) const;
+  };
+  struct TypeDeclarationEqual {
+    bool operator()(const Instruction* lhs, const Instruction* rhs) const;
+  };
+
+  /// Stores type declarations which need to be unique (i.e. non-aggregates).
+  /// The instructions' own words serve as the keys, so registering a type
+  /// does not copy them.
+  std::unordered_set<const Instruction*, TypeDeclarationHash,
+                     TypeDeclarationEqual>
+      unique_type_declarations_;
 
   AssemblyGrammar grammar_;
 
@@ -950,6 +1039,18 @@ class ValidationState_t {
   std::unordered_map<uint32_t, std::vector<uint32_t>> function_to_entry_points_;
   const std::vector<uint32_t> empty_ids_;
 
+  /// Mapping function -> sorted, distinct entry points which can (indirectly)
+  /// call the function.
+  std::unordered_map<uint32_t, std::vector<uint32_t>>
+      function_entry_point_references_;
+
+  /// Mapping global id -> sorted entry points which statically use it. Ids
+  /// used by no entry point are left out.
+  std::unordered_map<uint32_t, std::vector<uint32_t>> entry_point_references_;
+
+  /// Cache of block layout computations.
+  LayoutCache layout_cache_;
+
   // The IDs of types of pointers to Block-decorated structs in Uniform storage
   // class. This is populated at the start of ValidateDecorations.
   std::unordered_set<uint32_t> pointer_to_uniform_block_;
@@ -967,9 +1068,11 @@ class ValidationState_t {
   // TypePass.
   std::unordered_set<uint32_t> pointer_to_storage_image_;
 
-  /// Maps ids to friendly names.
-  std::unique_ptr<spvtools::FriendlyNameMapper> friendly_mapper_;
-  spvtools::NameMapper name_mapper_;
+  /// Maps ids to friendly names. Built on first use by friendly_name_mapper()
+  /// since it needs another parse of the module, which only diagnostics need.
+  mutable std::once_flag friendly_mapper_once_;
+  mutable std::unique_ptr<spvtools::FriendlyNameMapper> friendly_mapper_;
+  mutable spvtools::NameMapper friendly_name_mapper_;
 
   /// Variables used to reduce the number of diagnostic messages.
   uint32_t num_of_warnings_;
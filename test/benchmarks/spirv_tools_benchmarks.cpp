@@ -0,0 +1,310 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Performance benchmarks for the assembler, binary parser, validator,
+// optimizer, disassembler and linker.
+//
+// Every module in the checked-in corpus (test/benchmarks/corpus) is loaded
+// once at startup and registered as its own benchmark instance, so results are
+// reported per stage and per module.  Modules are read either as assembly
+// (*.spvasm) or as binaries (*.spv).  The modules under corpus/link/ are linked
+// together as a single program.
+//
+// Further corpus directories, for example with large shaders that can't be
+// checked in, can be added with --corpus_dir=<path>, which may be repeated.
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "spirv-tools/libspirv.h"
+#include "spirv-tools/libspirv.hpp"
+#include "spirv-tools/linker.hpp"
+#include "spirv-tools/optimizer.hpp"
+
+namespace spvtools {
+namespace benchmarks {
+namespace {
+
+constexpr spv_target_env kTargetEnv = SPV_ENV_UNIVERSAL_1_3;
+
+// A module of the benchmark corpus, in both text and binary form.
+struct CorpusModule {
+  std::string name;
+  std::string text;
+  std::vector<uint32_t> binary;
+};
+
+void IgnoreMessage(spv_message_level_t, const char*, const spv_position_t&,
+                   const char*) {}
+
+// Reads every .spvasm and .spv file directly inside |dir|, sorted by file
+// name, and fills in both the text and the binary form of each module.
+// Returns false if any of them fails to assemble or disassemble.
+bool LoadCorpus(const std::filesystem::path& dir,
+                std::vector<CorpusModule>* modules) {
+  std::vector<std::filesystem::path> paths;
+  std::error_code ec;
+  for (const auto& entry : std::filesystem::directory_iterator(dir, ec)) {
+    if (entry.is_regular_file() && (entry.path().extension() == ".spvasm" ||
+                                    entry.path().extension() == ".spv")) {
+      paths.push_back(entry.path());
+    }
+  }
+  if (ec) {
+    std::cerr << "error: cannot read corpus directory " << dir << ": "
+              << ec.message() << std::endl;
+    return false;
+  }
+  std::sort(paths.begin(), paths.end());
+
+  SpirvTools tools(kTargetEnv);
+  for (const auto& path : paths) {
+    std::ifstream file(path, std::ios::binary);
+    std::stringstream contents;
+    contents << file.rdbuf();
+
+    CorpusModule module;
+    module.name = path.stem().string();
+    tools.SetMessageConsumer([&path](spv_message_level_t, const char*,
+                                     const spv_position_t& position,
+                                     const char* message) {
+      std::cerr << "error: " << path.string() << ":" << position.line + 1
+                << ": " << message << std::endl;
+    });
+    if (path.extension() == ".spv") {
+      const std::string bytes = contents.str();
+      if (bytes.size() % sizeof(uint32_t) != 0) {
+        std::cerr << "error: " << path.string()
+                  << ": size is not a multiple of 4 bytes" << std::endl;
+        return false;
+      }
+      module.binary.resize(bytes.size() / sizeof(uint32_t));
+      std::copy(bytes.begin(), bytes.end(),
+                reinterpret_cast<char*>(module.binary.data()));
+      if (!tools.Disassemble(module.binary, &module.text,
+                             SPV_BINARY_TO_TEXT_OPTION_FRIENDLY_NAMES)) {
+        return false;
+      }
+    } else {
+      module.text = contents.str();
+      if (!tools.Assemble(module.text, &module.binary)) {
+        return false;
+      }
+    }
+    modules->push_back(std::move(module));
+  }
+  return true;
+}
+
+void BM_Assemble(benchmark::State& state, const CorpusModule* module) {
+  spv_context context = spvContextCreate(kTargetEnv);
+  for (auto _ : state) {
+    spv_binary binary = nullptr;
+    spv_diagnostic diagnostic = nullptr;
+    spv_result_t result =
+        spvTextToBinary(context, module->text.data(), module->text.size(),
+                        &binary, &diagnostic);
+    spvBinaryDestroy(binary);
+    spvDiagnosticDestroy(diagnostic);
+    if (result != SPV_SUCCESS) {
+      state.SkipWithError("spvTextToBinary failed");
+      break;
+    }
+  }
+  state.SetBytesProcessed(int64_t(state.iterations()) *
+                          int64_t(module->text.size()));
+  spvContextDestroy(context);
+}
+
+void BM_Parse(benchmark::State& state, const CorpusModule* module) {
+  spv_context context = spvContextCreate(kTargetEnv);
+  size_t num_instructions = 0;
+  const auto count_instruction = [](void* user_data,
+                                    const spv_parsed_instruction_t*) {
+    ++*static_cast<size_t*>(user_data);
+    return SPV_SUCCESS;
+  };
+  for (auto _ : state) {
+    num_instructions = 0;
+    spv_result_t result = spvBinaryParse(
+        context, &num_instructions, module->binary.data(),
+        module->binary.size(), nullptr, count_instruction, nullptr);
+    if (result != SPV_SUCCESS) {
+      state.SkipWithError("spvBinaryParse failed");
+      break;
+    }
+    benchmark::DoNotOptimize(num_instructions);
+  }
+  state.SetBytesProcessed(int64_t(state.iterations()) *
+                          int64_t(module->binary.size() * sizeof(uint32_t)));
+  state.counters["instructions"] = double(num_instructions);
+  spvContextDestroy(context);
+}
+
+void BM_Validate(benchmark::State& state, const CorpusModule* module) {
+  spv_context context = spvContextCreate(kTargetEnv);
+  spv_validator_options options = spvValidatorOptionsCreate();
+  const spv_const_binary_t binary = {module->binary.data(),
+                                     module->binary.size()};
+  for (auto _ : state) {
+    spv_diagnostic diagnostic = nullptr;
+    spv_result_t result =
+        spvValidateWithOptions(context, options, &binary, &diagnostic);
+    spvDiagnosticDestroy(diagnostic);
+    if (result != SPV_SUCCESS) {
+      state.SkipWithError("spvValidateWithOptions failed");
+      break;
+    }
+  }
+  state.SetBytesProcessed(int64_t(state.iterations()) *
+                          int64_t(module->binary.size() * sizeof(uint32_t)));
+  spvValidatorOptionsDestroy(options);
+  spvContextDestroy(context);
+}
+
+void BM_Disassemble(benchmark::State& state, const CorpusModule* module) {
+  spv_context context = spvContextCreate(kTargetEnv);
+  for (auto _ : state) {
+    spv_text text = nullptr;
+    spv_diagnostic diagnostic = nullptr;
+    spv_result_t result = spvBinaryToText(
+        context, module->binary.data(), module->binary.size(),
+        SPV_BINARY_TO_TEXT_OPTION_FRIENDLY_NAMES, &text, &diagnostic);
+    spvTextDestroy(text);
+    spvDiagnosticDestroy(diagnostic);
+    if (result != SPV_SUCCESS) {
+      state.SkipWithError("spvBinaryToText failed");
+      break;
+    }
+  }
+  state.SetBytesProcessed(int64_t(state.iterations()) *
+                          int64_t(module->binary.size() * sizeof(uint32_t)));
+  spvContextDestroy(context);
+}
+
+// Runs the pass recipe installed by |register_passes| over |module|.  The
+// optimizer is rebuilt on every iteration, as a compiler driver would.
+void BM_Optimize(benchmark::State& state, const CorpusModule* module,
+                 std::function<void(Optimizer*)> register_passes) {
+  for (auto _ : state) {
+    Optimizer optimizer(kTargetEnv);
+    optimizer.SetMessageConsumer(IgnoreMessage);
+    register_passes(&optimizer);
+    std::vector<uint32_t> optimized;
+    if (!optimizer.Run(module->binary.data(), module->binary.size(),
+                       &optimized)) {
+      state.SkipWithError("Optimizer::Run failed");
+      break;
+    }
+    benchmark::DoNotOptimize(optimized.data());
+  }
+  state.SetBytesProcessed(int64_t(state.iterations()) *
+                          int64_t(module->binary.size() * sizeof(uint32_t)));
+}
+
+void BM_Link(benchmark::State& state,
+             const std::vector<CorpusModule>* modules) {
+  Context context(kTargetEnv);
+  context.SetMessageConsumer(IgnoreMessage);
+  std::vector<std::vector<uint32_t>> binaries;
+  size_t total_words = 0;
+  for (const auto& module : *modules) {
+    binaries.push_back(module.binary);
+    total_words += module.binary.size();
+  }
+  for (auto _ : state) {
+    std::vector<uint32_t> linked;
+    if (Link(context, binaries, &linked) != SPV_SUCCESS) {
+      state.SkipWithError("spvtools::Link failed");
+      break;
+    }
+    benchmark::DoNotOptimize(linked.data());
+  }
+  state.SetBytesProcessed(int64_t(state.iterations()) *
+                          int64_t(total_words * sizeof(uint32_t)));
+}
+
+void RegisterBenchmarks(const std::vector<CorpusModule>& modules,
+                        const std::vector<CorpusModule>& link_modules) {
+  for (const auto& module : modules) {
+    const CorpusModule* m = &module;
+    benchmark::RegisterBenchmark(("Assemble/" + m->name).c_str(), BM_Assemble,
+                                 m);
+    benchmark::RegisterBenchmark(("Parse/" + m->name).c_str(), BM_Parse, m);
+    benchmark::RegisterBenchmark(("Validate/" + m->name).c_str(), BM_Validate,
+                                 m);
+    benchmark::RegisterBenchmark(("Disassemble/" + m->name).c_str(),
+                                 BM_Disassemble, m);
+    benchmark::RegisterBenchmark(
+        ("Optimize/Performance/" + m->name).c_str(), BM_Optimize, m,
+        [](Optimizer* opt) { opt->RegisterPerformancePasses(); });
+    benchmark::RegisterBenchmark(
+        ("Optimize/Size/" + m->name).c_str(), BM_Optimize, m,
+        [](Optimizer* opt) { opt->RegisterSizePasses(); });
+    benchmark::RegisterBenchmark(
+        ("Optimize/Legalization/" + m->name).c_str(), BM_Optimize, m,
+        [](Optimizer* opt) { opt->RegisterLegalizationPasses(); });
+  }
+  if (!link_modules.empty()) {
+    benchmark::RegisterBenchmark("Link/corpus", BM_Link, &link_modules);
+  }
+}
+
+}  // namespace
+}  // namespace benchmarks
+}  // namespace spvtools
+
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+
+  // Take out the --corpus_dir flags before checking for unknown arguments.
+  const std::string corpus_flag = "--corpus_dir=";
+  std::vector<std::filesystem::path> extra_corpus_dirs;
+  int num_args = 1;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg.compare(0, corpus_flag.size(), corpus_flag) == 0) {
+      extra_corpus_dirs.emplace_back(arg.substr(corpus_flag.size()));
+    } else {
+      argv[num_args++] = argv[i];
+    }
+  }
+  argc = num_args;
+  argv[argc] = nullptr;
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+
+  const std::filesystem::path corpus_dir(SPIRV_BENCHMARK_CORPUS_DIR);
+  std::vector<spvtools::benchmarks::CorpusModule> modules;
+  std::vector<spvtools::benchmarks::CorpusModule> link_modules;
+  if (!spvtools::benchmarks::LoadCorpus(corpus_dir, &modules) ||
+      !spvtools::benchmarks::LoadCorpus(corpus_dir / "link", &link_modules)) {
+    return 1;
+  }
+  for (const auto& dir : extra_corpus_dirs) {
+    if (!spvtools::benchmarks::LoadCorpus(dir, &modules)) return 1;
+  }
+
+  spvtools::benchmarks::RegisterBenchmarks(modules, link_modules);
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
@@ -18,6 +18,9 @@
 #include <vector>
 
 #include "gmock/gmock.h"
+#include "source/assembly_grammar.h"
+#include "source/disassemble.h"
+#include "source/name_mapper.h"
 #include "source/spirv_constant.h"
 #include "test/test_fixture.h"
 #include "test/unit_spirv.h"
@@ -167,6 +170,152 @@ TEST_F(BinaryToText, InvalidMagicNumber) {
   spvDiagnosticDestroy(diagnostic);
 }
 
+// A copy of an instruction delivered by the binary parser.
+struct ParsedInstruction {
+  std::vector<uint32_t> words;
+  std::vector<spv_parsed_operand_t> operands;
+  spv_parsed_instruction_t inst;
+};
+
+spv_result_t CollectInstruction(void* user_data,
+                                const spv_parsed_instruction_t* parsed) {
+  auto* instructions = static_cast<std::vector<ParsedInstruction>*>(user_data);
+  instructions->push_back({{parsed->words, parsed->words + parsed->num_words},
+                           {parsed->operands,
+                            parsed->operands + parsed->num_operands},
+                           *parsed});
+  return SPV_SUCCESS;
+}
+
+// Returns the instructions of the given module, in order.
+std::vector<ParsedInstruction> ParseInstructions(spv_const_context context,
+                                                 spv_const_binary binary) {
+  std::vector<ParsedInstruction> instructions;
+  EXPECT_EQ(SPV_SUCCESS,
+            spvBinaryParse(context, &instructions, binary->code,
+                           binary->wordCount, nullptr, CollectInstruction,
+                           nullptr));
+  for (auto& parsed : instructions) {
+    parsed.inst.words = parsed.words.data();
+    parsed.inst.operands = parsed.operands.data();
+  }
+  return instructions;
+}
+
+// Returns the lines of the disassembly of the given module.
+std::vector<std::string> DisassembleLines(spv_const_context context,
+                                          spv_const_binary binary,
+                                          uint32_t options) {
+  spv_text text = nullptr;
+  EXPECT_EQ(SPV_SUCCESS, spvBinaryToText(context, binary->code,
+                                         binary->wordCount, options, &text,
+                                         nullptr));
+  std::vector<std::string> lines;
+  std::stringstream stream(std::string(text->str, text->length));
+  for (std::string line; std::getline(stream, line);) lines.push_back(line);
+  spvTextDestroy(text);
+  return lines;
+}
+
+const char kNamedModule[] = R"(OpCapability Shader
+%glsl = OpExtInstImport "GLSL.std.450"
+OpMemoryModel Logical GLSL450
+OpEntryPoint Fragment %main "main" %color
+OpExecutionMode %main OriginUpperLeft
+OpName %main "main"
+OpName %color "color"
+OpName %Block "Block"
+OpMemberName %Block 0 "scale"
+OpDecorate %color Location 0
+OpMemberDecorate %Block 0 Offset 0
+%void = OpTypeVoid
+%fn = OpTypeFunction %void
+%float = OpTypeFloat 32
+%v4float = OpTypeVector %float 4
+%Block = OpTypeStruct %float
+%ptr_Output_v4float = OpTypePointer Output %v4float
+%color = OpVariable %ptr_Output_v4float Output
+%float_1 = OpConstant %float 1
+%ones = OpConstantComposite %v4float %float_1 %float_1 %float_1 %float_1
+%main = OpFunction %void None %fn
+%entry = OpLabel
+%sqrt = OpExtInst %v4float %glsl Sqrt %ones
+%sum = OpFAdd %v4float %sqrt %ones
+OpStore %color %sum
+OpReturn
+OpFunctionEnd
+)";
+
+// Disassembling a parsed instruction with a name mapper built once for the
+// module gives the same text as disassembling it by parsing the module again,
+// and as the matching line of the module's disassembly.
+TEST_F(BinaryToText, InstructionWithCachedNameMapperMatchesModuleParse) {
+  CompileSuccessfully(kNamedModule);
+  const AssemblyGrammar grammar(context);
+  ASSERT_TRUE(grammar.isValid());
+  FriendlyNameMapper friendly_mapper(context, binary->code, binary->wordCount);
+  const std::vector<ParsedInstruction> instructions =
+      ParseInstructions(context, binary);
+
+  for (bool friendly : {false, true}) {
+    SCOPED_TRACE(friendly ? "friendly names" : "numeric ids");
+    const uint32_t options =
+        SPV_BINARY_TO_TEXT_OPTION_NO_HEADER |
+        (friendly ? SPV_BINARY_TO_TEXT_OPTION_FRIENDLY_NAMES : 0);
+    const NameMapper name_mapper = friendly ? friendly_mapper.GetNameMapper()
+                                            : GetTrivialNameMapper();
+    const std::vector<std::string> lines =
+        DisassembleLines(context, binary, options);
+    ASSERT_EQ(instructions.size(), lines.size());
+
+    for (size_t i = 0; i < instructions.size(); ++i) {
+      const ParsedInstruction& parsed = instructions[i];
+      const std::string reparsed = spvInstructionBinaryToText(
+          SPV_ENV_UNIVERSAL_1_0, parsed.words.data(), parsed.words.size(),
+          binary->code, binary->wordCount, options);
+      const std::string cached = spvInstructionBinaryToText(
+          grammar, parsed.inst, name_mapper, options);
+      EXPECT_EQ(lines[i], reparsed);
+      EXPECT_EQ(reparsed, cached);
+    }
+  }
+}
+
+TEST_F(BinaryToText, InstructionWithCachedNameMapperUsesFriendlyNames) {
+  CompileSuccessfully(kNamedModule);
+  const AssemblyGrammar grammar(context);
+  FriendlyNameMapper friendly_mapper(context, binary->code, binary->wordCount);
+  const std::vector<ParsedInstruction> instructions =
+      ParseInstructions(context, binary);
+  const uint32_t options = SPV_BINARY_TO_TEXT_OPTION_NO_HEADER |
+                           SPV_BINARY_TO_TEXT_OPTION_FRIENDLY_NAMES;
+
+  const ParsedInstruction& store = instructions[instructions.size() - 3];
+  ASSERT_EQ(uint16_t(spv::Op::OpStore), store.inst.opcode);
+  EXPECT_EQ("OpStore %color %14",
+            spvInstructionBinaryToText(grammar, store.inst,
+                                       friendly_mapper.GetNameMapper(),
+                                       options));
+}
+
+TEST_F(BinaryToText, InstructionWithCachedNameMapperIgnoresPrintAndOffsets) {
+  CompileSuccessfully(kNamedModule);
+  const AssemblyGrammar grammar(context);
+  const std::vector<ParsedInstruction> instructions =
+      ParseInstructions(context, binary);
+  const NameMapper name_mapper = GetTrivialNameMapper();
+  const uint32_t options = SPV_BINARY_TO_TEXT_OPTION_NO_HEADER;
+
+  for (const ParsedInstruction& parsed : instructions) {
+    EXPECT_EQ(
+        spvInstructionBinaryToText(grammar, parsed.inst, name_mapper, options),
+        spvInstructionBinaryToText(
+            grammar, parsed.inst, name_mapper,
+            options | SPV_BINARY_TO_TEXT_OPTION_PRINT |
+                SPV_BINARY_TO_TEXT_OPTION_SHOW_BYTE_OFFSET));
+  }
+}
+
 struct FailedDecodeCase {
   std::string source_text;
   std::vector<uint32_t> appended_instruction;
@@ -12,6 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <string>
+#include <vector>
+
 #include "gtest/gtest.h"
 #include "source/table.h"
 #include "spirv-tools/libspirv.h"
@@ -301,5 +304,79 @@ TEST(CInterface, SpecifyConsumerSpecifyDiagnosticForValidating) {
   spvContextDestroy(context);
 }
 
+TEST(CInterface, ValidateBinariesReportsPerModuleDiagnostics) {
+  const char valid_text[] =
+      "OpCapability Shader\nOpCapability Linkage\n"
+      "OpMemoryModel Logical GLSL450\n";
+  const char invalid_text[] = "OpNop";
+
+  auto context = spvContextCreate(SPV_ENV_UNIVERSAL_1_1);
+  std::vector<std::string> messages;
+  SetContextMessageConsumer(
+      context,
+      [&messages](spv_message_level_t level, const char*,
+                  const spv_position_t&, const char* message) {
+        EXPECT_EQ(SPV_MSG_ERROR, level);
+        messages.push_back(message);
+      });
+
+  spv_binary valid = nullptr;
+  spv_binary invalid = nullptr;
+  ASSERT_EQ(SPV_SUCCESS, spvTextToBinary(context, valid_text,
+                                         sizeof(valid_text), &valid, nullptr));
+  ASSERT_EQ(SPV_SUCCESS,
+            spvTextToBinary(context, invalid_text, sizeof(invalid_text),
+                            &invalid, nullptr));
+
+  std::vector<spv_const_binary_t> binaries;
+  for (int i = 0; i < 8; ++i) {
+    spv_binary b = (i % 2) ? invalid : valid;
+    binaries.push_back({b->code, b->wordCount});
+  }
+  std::vector<spv_result_t> results(binaries.size(), SPV_SUCCESS);
+  std::vector<spv_diagnostic> diagnostics(binaries.size(), nullptr);
+
+  auto options = spvValidatorOptionsCreate();
+  EXPECT_EQ(SPV_ERROR_INVALID_LAYOUT,
+            spvValidateBinaries(context, options, binaries.data(),
+                                binaries.size(), 4, results.data(),
+                                diagnostics.data()));
+
+  // Consumer should not be invoked at all.
+  EXPECT_TRUE(messages.empty());
+  for (size_t i = 0; i < binaries.size(); ++i) {
+    if (i % 2) {
+      EXPECT_EQ(SPV_ERROR_INVALID_LAYOUT, results[i]);
+      ASSERT_NE(nullptr, diagnostics[i]);
+      EXPECT_STREQ(
+          "Nop cannot appear before the memory model instruction\n"
+          "  OpNop\n",
+          diagnostics[i]->error);
+    } else {
+      EXPECT_EQ(SPV_SUCCESS, results[i]);
+      EXPECT_EQ(nullptr, diagnostics[i]);
+    }
+    spvDiagnosticDestroy(diagnostics[i]);
+  }
+
+  // Without diagnostics, every failure is sent to the consumer, in module
+  // order and prefixed with the index of the module.
+  EXPECT_EQ(SPV_ERROR_INVALID_LAYOUT,
+            spvValidateBinaries(context, options, binaries.data(),
+                                binaries.size(), 0, results.data(), nullptr));
+  ASSERT_EQ(4u, messages.size());
+  for (size_t i = 0; i < messages.size(); ++i) {
+    EXPECT_EQ("module " + std::to_string(2 * i + 1) +
+                  ": Nop cannot appear before the memory model instruction\n"
+                  "  OpNop\n",
+              messages[i]);
+  }
+
+  spvValidatorOptionsDestroy(options);
+  spvBinaryDestroy(valid);
+  spvBinaryDestroy(invalid);
+  spvContextDestroy(context);
+}
+
 }  // namespace
 }  // namespace spvtools
@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
@@ -26,6 +28,7 @@ namespace {
 
 using ::testing::ContainerEq;
 using ::testing::HasSubstr;
+using ::testing::StartsWith;
 
 // Return a string that contains the minimum instructions needed to form
 // a valid module.  Other instructions can be appended to this string.
@@ -222,6 +225,104 @@ TEST(CppInterface, ValidateWithOptionsFail) {
           "Number of OpTypeStruct members (10) has exceeded the limit (9)"));
 }
 
+#if defined(SPIRV_TIMER_ENABLED)
+TEST(CppInterface, ValidateWithTimeReport) {
+  SpirvTools t(SPV_ENV_UNIVERSAL_1_1);
+  std::vector<uint32_t> binary;
+  EXPECT_TRUE(t.Assemble(MakeModuleHavingStruct(10), &binary));
+  ValidatorOptions opts;
+  std::stringstream report;
+  EXPECT_TRUE(opts.SetTimeReport(&report));
+
+  EXPECT_TRUE(t.Validate(binary.data(), binary.size(), opts));
+  EXPECT_THAT(report.str(), HasSubstr("Thread CPU time"));
+  EXPECT_THAT(report.str(), HasSubstr("WALL time"));
+  EXPECT_THAT(report.str(), HasSubstr("Parse ("));
+  EXPECT_THAT(report.str(), HasSubstr("IdPass ("));
+  EXPECT_THAT(report.str(), HasSubstr("TypePass ("));
+  EXPECT_THAT(report.str(), HasSubstr("PerformCfgChecks ("));
+  EXPECT_THAT(report.str(), HasSubstr("ValidateBuiltIns ("));
+}
+
+TEST(CppInterface, ValidateBatchWithTimeReport) {
+  SpirvTools t(SPV_ENV_UNIVERSAL_1_1);
+  std::vector<uint32_t> binary;
+  EXPECT_TRUE(t.Assemble(MakeModuleHavingStruct(10), &binary));
+  ValidatorOptions opts;
+  std::stringstream report;
+  EXPECT_TRUE(opts.SetTimeReport(&report));
+
+  const size_t num_modules = 16;
+  std::vector<spv_result_t> results;
+  EXPECT_TRUE(t.Validate(std::vector<std::vector<uint32_t>>(num_modules,
+                                                            binary),
+                         opts, &results, 4));
+
+  // Each module's report is written in one piece: every header is followed
+  // by the stages of a single validation.
+  std::vector<std::vector<std::string>> reports;
+  std::string line;
+  while (std::getline(report, line)) {
+    if (line.find("Stage (instructions)") != std::string::npos) {
+      reports.emplace_back();
+    } else {
+      ASSERT_FALSE(reports.empty()) << line;
+      reports.back().push_back(line);
+    }
+  }
+  ASSERT_EQ(num_modules, reports.size());
+  for (const auto& stages : reports) {
+    EXPECT_EQ(reports[0].size(), stages.size());
+    EXPECT_EQ(1, std::count_if(stages.begin(), stages.end(),
+                               [](const std::string& stage) {
+                                 return stage.find("Parse (") !=
+                                        std::string::npos;
+                               }));
+  }
+}
+#else
+TEST(CppInterface, TimeReportUnavailable) {
+  SpirvTools t(SPV_ENV_UNIVERSAL_1_1);
+  std::vector<uint32_t> binary;
+  EXPECT_TRUE(t.Assemble(MakeModuleHavingStruct(10), &binary));
+  ValidatorOptions opts;
+  std::stringstream report;
+  EXPECT_FALSE(opts.SetTimeReport(&report));
+  EXPECT_TRUE(opts.SetTimeReport(nullptr));
+
+  EXPECT_TRUE(t.Validate(binary.data(), binary.size(), opts));
+  EXPECT_EQ("", report.str());
+}
+#endif  // defined(SPIRV_TIMER_ENABLED)
+
+TEST(CppInterface, ValidateBatch) {
+  SpirvTools t(SPV_ENV_UNIVERSAL_1_1);
+  std::vector<uint32_t> good;
+  std::vector<uint32_t> too_many_members;
+  EXPECT_TRUE(t.Assemble(MakeModuleHavingStruct(5), &good));
+  EXPECT_TRUE(t.Assemble(MakeModuleHavingStruct(10), &too_many_members));
+  ValidatorOptions opts;
+  opts.SetUniversalLimit(spv_validator_limit_max_struct_members, 9);
+  std::vector<std::string> messages;
+  t.SetMessageConsumer([&messages](spv_message_level_t, const char*,
+                                   const spv_position_t&,
+                                   const char* message) {
+    messages.push_back(message);
+  });
+
+  std::vector<spv_result_t> results;
+  EXPECT_TRUE(t.Validate({good, good, good}, opts, &results, 2));
+  EXPECT_THAT(results, ContainerEq(std::vector<spv_result_t>(3, SPV_SUCCESS)));
+  EXPECT_TRUE(messages.empty());
+
+  EXPECT_FALSE(t.Validate({good, too_many_members, good}, opts, &results));
+  EXPECT_THAT(results, ContainerEq(std::vector<spv_result_t>{
+                           SPV_SUCCESS, SPV_ERROR_INVALID_BINARY,
+                           SPV_SUCCESS}));
+  ASSERT_EQ(1u, messages.size());
+  EXPECT_THAT(messages[0], StartsWith("module 1: "));
+}
+
 // Checks that after running the given optimizer |opt| on the given |original|
 // source code, we can get the given |optimized| source code.
 void CheckOptimization(const std::string& original,
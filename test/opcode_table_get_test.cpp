@@ -12,6 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <string>
+#include <vector>
+
 #include "gmock/gmock.h"
 #include "test/unit_spirv.h"
 
@@ -28,6 +31,42 @@ TEST_P(GetTargetOpcodeTableGetTest, IntegrityCheck) {
   ASSERT_NE(nullptr, table->entries);
 }
 
+TEST_P(GetTargetOpcodeTableGetTest, NameIndexIsSortedPermutation) {
+  spv_opcode_table table;
+  ASSERT_EQ(SPV_SUCCESS, spvOpcodeTableGet(&table, GetParam()));
+  ASSERT_NE(nullptr, table->nameIndex);
+  std::vector<bool> seen(table->count, false);
+  for (uint32_t i = 0; i < table->count; ++i) {
+    const uint16_t index = table->nameIndex[i];
+    ASSERT_LT(index, table->count);
+    EXPECT_FALSE(seen[index]);
+    seen[index] = true;
+    if (i > 0) {
+      EXPECT_LE(std::string(table->entries[table->nameIndex[i - 1]].name),
+                std::string(table->entries[index].name));
+    }
+  }
+}
+
+TEST_P(GetTargetOpcodeTableGetTest, EveryNameIsFound) {
+  spv_opcode_table table;
+  ASSERT_EQ(SPV_SUCCESS, spvOpcodeTableGet(&table, GetParam()));
+  for (uint32_t i = 0; i < table->count; ++i) {
+    const spv_opcode_desc_t& entry = table->entries[i];
+    spv_opcode_desc found = nullptr;
+    if (SPV_SUCCESS ==
+        spvOpcodeTableNameLookup(GetParam(), table, entry.name, &found)) {
+      EXPECT_STREQ(entry.name, found->name);
+    }
+  }
+  spv_opcode_desc found = nullptr;
+  EXPECT_EQ(SPV_ERROR_INVALID_LOOKUP,
+            spvOpcodeTableNameLookup(GetParam(), table, "OpNotAnOpcode",
+                                     &found));
+  EXPECT_EQ(SPV_ERROR_INVALID_LOOKUP,
+            spvOpcodeTableNameLookup(GetParam(), table, "", &found));
+}
+
 TEST_P(GetTargetOpcodeTableGetTest, InvalidPointerTable) {
   ASSERT_EQ(SPV_ERROR_INVALID_POINTER, spvOpcodeTableGet(nullptr, GetParam()));
 }
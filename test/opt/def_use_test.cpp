@@ -1430,6 +1430,33 @@ TEST(AnalyzeInstDefUse, AddNewInstruction) {
   CheckUse(expected, &manager, context->module()->IdBound());
 }
 
+TEST(AnalyzeInstDefUse, UsersClearedDuringIteration) {
+  const std::string input = R"(
+%1 = OpTypeBool
+%2 = OpConstantTrue %1
+%3 = OpConstantFalse %1
+%4 = OpConstantTrue %1
+)";
+
+  std::unique_ptr<IRContext> context =
+      BuildModule(SPV_ENV_UNIVERSAL_1_1, nullptr, input);
+  ASSERT_NE(nullptr, context);
+  DefUseManager manager(context->module());
+
+  // Clearing the current user and a later user while visiting the users of %1
+  // skips the cleared users without disturbing the iteration.
+  std::vector<uint32_t> visited;
+  manager.ForEachUser(1, [&manager, &visited](Instruction* user) {
+    visited.push_back(user->result_id());
+    if (user->result_id() == 2) {
+      manager.ClearInst(user);
+      manager.ClearInst(manager.GetDef(3));
+    }
+  });
+  EXPECT_EQ((std::vector<uint32_t>{2, 4}), visited);
+  EXPECT_EQ(1u, manager.NumUsers(1));
+}
+
 struct KillInstTestCase {
   const char* before;
   std::unordered_set<uint32_t> indices_for_inst_to_kill;
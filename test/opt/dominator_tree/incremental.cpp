@@ -0,0 +1,155 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <string>
+
+#include "gmock/gmock.h"
+#include "source/opt/block_merge_pass.h"
+#include "source/opt/block_merge_util.h"
+#include "source/opt/cfg.h"
+#include "source/opt/dominator_analysis.h"
+#include "source/opt/ir_context.h"
+#include "test/opt/function_utils.h"
+#include "test/opt/pass_fixture.h"
+
+namespace spvtools {
+namespace opt {
+namespace {
+
+using ::testing::UnorderedElementsAre;
+using PassClassTest = PassTest<::testing::Test>;
+
+const std::string kHeader = R"(
+               OpCapability Shader
+               OpMemoryModel Logical GLSL450
+               OpEntryPoint Fragment %1 "main"
+               OpExecutionMode %1 OriginUpperLeft
+       %void = OpTypeVoid
+       %func = OpTypeFunction %void
+       %bool = OpTypeBool
+       %true = OpConstantTrue %bool
+)";
+
+// Checks that |tree| is the same as the tree built from scratch for |f|.  The
+// reference tree is built from a new CFG, so that it does not depend on the
+// CFG analysis of |context| being up to date.
+void ExpectSameAsRebuilt(IRContext* context, const Function* f,
+                         const DominatorTree& tree) {
+  CFG cfg(context->module());
+  DominatorTree rebuilt(tree.IsPostDominator());
+  rebuilt.InitializeTree(cfg, f);
+  for (const BasicBlock& a : *f) {
+    EXPECT_EQ(rebuilt.ReachableFromRoots(a.id()),
+              tree.ReachableFromRoots(a.id()))
+        << a.id();
+    const BasicBlock* expected_idom = rebuilt.ImmediateDominator(a.id());
+    const BasicBlock* idom = tree.ImmediateDominator(a.id());
+    EXPECT_EQ(expected_idom ? expected_idom->id() : 0, idom ? idom->id() : 0)
+        << a.id();
+    for (const BasicBlock& b : *f) {
+      EXPECT_EQ(rebuilt.Dominates(a.id(), b.id()),
+                tree.Dominates(a.id(), b.id()))
+          << a.id() << " " << b.id();
+    }
+  }
+}
+
+TEST_F(PassClassTest, DominatorsUpdatedForMergedBlocks) {
+  const std::string text = kHeader + R"(
+          %1 = OpFunction %void None %func
+          %2 = OpLabel
+               OpBranch %3
+          %3 = OpLabel
+               OpSelectionMerge %7 None
+               OpBranchConditional %true %4 %6
+          %4 = OpLabel
+               OpBranch %5
+          %5 = OpLabel
+               OpBranch %7
+          %6 = OpLabel
+               OpBranch %7
+          %7 = OpLabel
+               OpReturn
+               OpFunctionEnd
+)";
+  std::unique_ptr<IRContext> context =
+      BuildModule(SPV_ENV_UNIVERSAL_1_1, nullptr, text,
+                  SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS);
+  Function* f = spvtest::GetFunction(context->module(), 1);
+  DominatorAnalysis* dom = context->GetDominatorAnalysis(f);
+  PostDominatorAnalysis* post_dom = context->GetPostDominatorAnalysis(f);
+
+  // Merge %5 into %4, and then %3 into %2.
+  for (uint32_t id : {4u, 2u}) {
+    auto bi = f->FindBlock(id);
+    ASSERT_TRUE(blockmergeutil::CanMergeWithSuccessor(context.get(), &*bi));
+    blockmergeutil::MergeWithSuccessor(context.get(), f, bi);
+
+    EXPECT_TRUE(context->IsConsistent());
+    EXPECT_EQ(dom, context->GetDominatorAnalysis(f));
+    EXPECT_EQ(post_dom, context->GetPostDominatorAnalysis(f));
+    ExpectSameAsRebuilt(context.get(), f, dom->GetDomTree());
+    ExpectSameAsRebuilt(context.get(), f, post_dom->GetDomTree());
+  }
+  EXPECT_EQ(nullptr, dom->GetDomTree().GetTreeNode(5));
+  EXPECT_EQ(nullptr, post_dom->GetDomTree().GetTreeNode(3));
+}
+
+TEST_F(PassClassTest, BlockMergeKeepsDominatorsAndCFG) {
+  const std::string text = kHeader + R"(
+          %1 = OpFunction %void None %func
+          %2 = OpLabel
+               OpBranch %3
+          %3 = OpLabel
+               OpLoopMerge %7 %6 None
+               OpBranch %4
+          %4 = OpLabel
+               OpBranchConditional %true %5 %7
+          %5 = OpLabel
+               OpBranch %6
+          %6 = OpLabel
+               OpBranch %3
+          %7 = OpLabel
+               OpReturn
+               OpFunctionEnd
+)";
+  std::unique_ptr<IRContext> context =
+      BuildModule(SPV_ENV_UNIVERSAL_1_1, nullptr, text,
+                  SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS);
+  Function* f = spvtest::GetFunction(context->module(), 1);
+  DominatorAnalysis* dom = context->GetDominatorAnalysis(f);
+  PostDominatorAnalysis* post_dom = context->GetPostDominatorAnalysis(f);
+
+  BlockMergePass pass;
+  EXPECT_EQ(Pass::Status::SuccessWithChange, pass.Run(context.get()));
+
+  EXPECT_TRUE(context->AreAnalysesValid(IRContext::kAnalysisCFG |
+                                        IRContext::kAnalysisDominatorAnalysis));
+  EXPECT_TRUE(context->IsConsistent());
+  EXPECT_EQ(dom, context->GetDominatorAnalysis(f));
+  EXPECT_EQ(post_dom, context->GetPostDominatorAnalysis(f));
+  ExpectSameAsRebuilt(context.get(), f, dom->GetDomTree());
+  ExpectSameAsRebuilt(context.get(), f, post_dom->GetDomTree());
+
+  // %4 was merged into the loop header %3, and %6 into %5.
+  EXPECT_EQ(nullptr, dom->GetDomTree().GetTreeNode(4));
+  EXPECT_EQ(nullptr, dom->GetDomTree().GetTreeNode(6));
+  EXPECT_THAT(context->cfg()->preds(3), UnorderedElementsAre(2, 5));
+  EXPECT_THAT(context->cfg()->preds(7), UnorderedElementsAre(3));
+}
+
+}  // namespace
+}  // namespace opt
+}  // namespace spvtools
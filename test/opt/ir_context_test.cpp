@@ -194,6 +194,62 @@ TEST_F(IRContextTest, PreserveFirstOnlyAfterPassWithChange) {
   }
 }
 
+TEST_F(IRContextTest, InvalidateAnalysesOfOneFunction) {
+  const std::string text = R"(
+               OpCapability Shader
+               OpCapability Linkage
+               OpMemoryModel Logical GLSL450
+       %void = OpTypeVoid
+       %func = OpTypeFunction %void
+       %bool = OpTypeBool
+       %true = OpConstantTrue %bool
+          %1 = OpFunction %void None %func
+          %2 = OpLabel
+               OpSelectionMerge %4 None
+               OpBranchConditional %true %3 %4
+          %3 = OpLabel
+               OpBranch %4
+          %4 = OpLabel
+               OpReturn
+               OpFunctionEnd
+          %5 = OpFunction %void None %func
+          %6 = OpLabel
+               OpBranch %7
+          %7 = OpLabel
+               OpReturn
+               OpFunctionEnd
+)";
+  std::unique_ptr<IRContext> context =
+      BuildModule(SPV_ENV_UNIVERSAL_1_2, nullptr, text,
+                  SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS);
+  Function* changed = &*context->module()->begin();
+  Function* unchanged = &*++context->module()->begin();
+  context->GetDominatorAnalysis(changed);
+  DominatorAnalysis* unchanged_dom = context->GetDominatorAnalysis(unchanged);
+  LoopDescriptor* unchanged_loops = context->GetLoopDescriptor(unchanged);
+
+  // Make %2 branch straight to %4.
+  BasicBlock* block = context->get_instr_block(2);
+  context->KillInst(block->GetMergeInst());
+  block->terminator()->SetOpcode(spv::Op::OpBranch);
+  block->terminator()->SetInOperands({{SPV_OPERAND_TYPE_ID, {4}}});
+  context->InvalidateAnalysesExceptFor(changed, IRContext::kAnalysisNone);
+
+  // The analyses of the other function are kept.
+  EXPECT_TRUE(context->AreAnalysesValid(IRContext::kAnalysisCFG |
+                                        IRContext::kAnalysisDominatorAnalysis |
+                                        IRContext::kAnalysisLoopAnalysis));
+  EXPECT_FALSE(context->AreAnalysesValid(IRContext::kAnalysisDefUse));
+  EXPECT_EQ(unchanged_dom, context->GetDominatorAnalysis(unchanged));
+  EXPECT_EQ(unchanged_loops, context->GetLoopDescriptor(unchanged));
+
+  // The changed function sees its new CFG.
+  EXPECT_THAT(context->cfg()->preds(4), UnorderedElementsAre(2u, 3u));
+  EXPECT_TRUE(context->cfg()->preds(3).empty());
+  EXPECT_THAT(context->cfg()->preds(7), UnorderedElementsAre(6u));
+  EXPECT_FALSE(context->GetDominatorAnalysis(changed)->IsReachable(3));
+}
+
 TEST_F(IRContextTest, KillMemberName) {
   const std::string text = R"(
               OpCapability Shader
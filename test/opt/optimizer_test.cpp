@@ -25,6 +25,7 @@ namespace opt {
 namespace {
 
 using ::testing::Eq;
+using ::testing::HasSubstr;
 
 // Return a string that contains the minimum instructions needed to form
 // a valid module.  Other instructions can be appended to this string.
@@ -118,6 +119,87 @@ TEST(Optimizer, CanRunTransformingPassWithAliasedVectors) {
   EXPECT_THAT(disassembly, Eq(Header() + "%void = OpTypeVoid\n"));
 }
 
+TEST(Optimizer, CanRunSeveralOptimizersOnLoadedModule) {
+  SpirvTools tools(SPV_ENV_UNIVERSAL_1_0);
+  std::vector<uint32_t> binary;
+  tools.Assemble(Header() +
+                     "OpName %foo \"foo\"\n%foo = OpTypeInt 32 0\n"
+                     "%bar = OpTypeInt 32 0",
+                 &binary);
+
+  Optimizer strip(SPV_ENV_UNIVERSAL_1_0);
+  strip.RegisterPass(CreateStripDebugInfoPass());
+  Optimizer dedup(SPV_ENV_UNIVERSAL_1_0);
+  dedup.RegisterPass(CreateRemoveDuplicatesPass());
+
+  OptimizerModule module;
+  EXPECT_FALSE(module.IsLoaded());
+  ASSERT_TRUE(strip.Load(binary.data(), binary.size(), &module));
+  EXPECT_TRUE(strip.Run(&module));
+  EXPECT_TRUE(dedup.Run(&module));
+
+  std::vector<uint32_t> binary_out;
+  ASSERT_TRUE(module.ToBinary(&binary_out));
+  std::string disassembly;
+  tools.Disassemble(binary_out.data(), binary_out.size(), &disassembly);
+  EXPECT_THAT(disassembly, Eq(Header() + "%uint = OpTypeInt 32 0\n"));
+
+  // Running the optimizers on binaries one after the other gives the same
+  // result.
+  std::vector<uint32_t> expected;
+  ASSERT_TRUE(strip.Run(binary.data(), binary.size(), &expected));
+  ASSERT_TRUE(dedup.Run(expected.data(), expected.size(), &expected));
+  EXPECT_EQ(expected, binary_out);
+}
+
+TEST(Optimizer, RunFailsOnModuleThatIsNotLoaded) {
+  Optimizer opt(SPV_ENV_UNIVERSAL_1_0);
+  opt.RegisterPass(CreateNullPass());
+
+  OptimizerModule module;
+  EXPECT_FALSE(opt.Run(&module));
+  std::vector<uint32_t> binary;
+  EXPECT_FALSE(module.ToBinary(&binary));
+
+  // A binary that fails to validate leaves the module empty.
+  const std::vector<uint32_t> invalid = {0u, 1u, 2u};
+  EXPECT_FALSE(opt.Load(invalid.data(), invalid.size(), &module));
+  EXPECT_FALSE(module.IsLoaded());
+}
+
+TEST(Optimizer, RunRejectsModuleLoadedForOtherTargetEnv) {
+  SpirvTools tools(SPV_ENV_UNIVERSAL_1_0);
+  std::vector<uint32_t> binary;
+  tools.Assemble(Header(), &binary);
+
+  std::vector<std::string> load_messages;
+  Optimizer loader(SPV_ENV_UNIVERSAL_1_0);
+  loader.SetMessageConsumer([&load_messages](spv_message_level_t, const char*,
+                                             const spv_position_t&,
+                                             const char* m) {
+    load_messages.push_back(m);
+  });
+  std::vector<std::string> run_messages;
+  Optimizer runner(SPV_ENV_UNIVERSAL_1_1);
+  runner.RegisterPass(CreateNullPass());
+  runner.SetMessageConsumer([&run_messages](spv_message_level_t, const char*,
+                                            const spv_position_t&,
+                                            const char* m) {
+    run_messages.push_back(m);
+  });
+
+  OptimizerModule module;
+  ASSERT_TRUE(loader.Load(binary.data(), binary.size(), &module));
+  EXPECT_FALSE(runner.Run(&module));
+  EXPECT_TRUE(load_messages.empty());
+  ASSERT_EQ(1u, run_messages.size());
+  EXPECT_THAT(run_messages[0], HasSubstr("loaded for target environment"));
+
+  // The module is still usable by an optimizer for the same environment.
+  runner.SetTargetEnv(SPV_ENV_UNIVERSAL_1_0);
+  EXPECT_TRUE(runner.Run(&module));
+}
+
 TEST(Optimizer, CanValidateFlags) {
   Optimizer opt(SPV_ENV_UNIVERSAL_1_0);
   EXPECT_FALSE(opt.FlagHasValidForm("bad-flag"));
@@ -28,7 +28,9 @@ namespace opt {
 namespace {
 
 using spvtest::GetIdBound;
+using ::testing::ElementsAre;
 using ::testing::Eq;
+using ::testing::HasSubstr;
 
 // A null pass whose constructors accept arguments
 class NullPassWithArgs : public NullPass {
@@ -186,6 +188,50 @@ TEST(PassManager, RecomputeIdBoundAutomatically) {
   EXPECT_THAT(GetIdBound(*context.module()), Eq(201u));
 }
 
+// A pass that appends an OpTypeVoid instruction that uses a given id, but
+// reports that it made no change.
+class UnreportedTypeVoidInstPass : public AppendTypeVoidInstPass {
+ public:
+  using AppendTypeVoidInstPass::AppendTypeVoidInstPass;
+
+  Status Process() override {
+    AppendTypeVoidInstPass::Process();
+    return Status::SuccessWithoutChange;
+  }
+};
+
+TEST(PassManager, ValidateAfterAllChecksUnchangedModules) {
+  const std::string text = R"(
+OpCapability Shader
+OpCapability Linkage
+OpMemoryModel Logical GLSL450
+%void = OpTypeVoid
+)";
+
+  // The duplicate OpTypeVoid added by the second pass is invalid. The pass
+  // claims to have made no change, but the module is validated anyway.
+  std::unique_ptr<IRContext> context =
+      BuildModule(SPV_ENV_UNIVERSAL_1_2, nullptr, text);
+  // Make room for the new id, so that the duplicate type is the only error.
+  context->module()->SetIdBound(101);
+  std::vector<std::string> messages;
+  PassManager manager;
+  manager.SetMessageConsumer(
+      [&messages](spv_message_level_t, const char*, const spv_position_t&,
+                  const char* message) { messages.push_back(message); });
+  ValidatorOptions validator_options;
+  manager.SetValidatorOptions(validator_options);
+  manager.SetValidateAfterAll(true);
+  manager.AddPass<NullPass>();
+  manager.AddPass(MakeUnique<UnreportedTypeVoidInstPass>(100));
+  EXPECT_EQ(Pass::Status::Failure, manager.Run(context.get()));
+  EXPECT_THAT(messages,
+              ElementsAre(HasSubstr("Duplicate non-aggregate type "
+                                    "declarations are not allowed."),
+                          "Validation failed after pass "
+                          "AppendTypeVoidInstPass"));
+}
+
 }  // anonymous namespace
 }  // namespace opt
 }  // namespace spvtools
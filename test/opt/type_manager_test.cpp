@@ -517,6 +517,69 @@ TEST(TypeManager, PartialIsomorphicFwdPtr) {
             p200->AsPointer()->pointee_type());
 }
 
+TEST(TypeManager, PooledTypesMatchUnpooledCopies) {
+  const std::string text = R"(
+               OpCapability Addresses
+               OpCapability Kernel
+               OpMemoryModel Physical64 OpenCL
+               OpTypeForwardPointer %100 CrossWorkgroup
+       %void = OpTypeVoid
+        %int = OpTypeInt 32 0
+      %float = OpTypeFloat 32
+      %v4int = OpTypeVector %int 4
+        %150 = OpTypeStruct %100 %v4int
+        %100 = OpTypePointer CrossWorkgroup %150
+        %200 = OpTypeStruct %v4int %float
+        %300 = OpTypePointer CrossWorkgroup %200
+        %400 = OpTypeFunction %void %100 %300
+  )";
+
+  std::unique_ptr<IRContext> context =
+      BuildModule(SPV_ENV_UNIVERSAL_1_1, nullptr, text,
+                  SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS);
+  TypeManager manager(nullptr, context.get());
+
+  // Copies of pooled types are not pooled, so their hashes are computed from
+  // scratch. They must agree with the hashes cached in the pool.
+  for (uint32_t id : {100u, 150u, 200u, 300u, 400u}) {
+    Type* type = manager.GetType(id);
+    ASSERT_NE(type, nullptr);
+    std::unique_ptr<Type> copy = type->Clone();
+    EXPECT_EQ(type->HashValue(), copy->HashValue()) << id;
+    EXPECT_TRUE(type->IsSame(copy.get())) << id;
+    EXPECT_TRUE(copy->IsSame(type)) << id;
+    EXPECT_EQ(manager.GetRegisteredType(copy.get()), type) << id;
+  }
+
+  // Distinct pooled types compare unequal without a structural walk.
+  EXPECT_FALSE(manager.GetType(150)->IsSame(manager.GetType(200)));
+  EXPECT_FALSE(manager.GetType(100)->IsSame(manager.GetType(300)));
+}
+
+TEST(TypeManager, PoolDuplicatesAreDetected) {
+  const std::string text = R"(
+               OpCapability Shader
+               OpMemoryModel Logical GLSL450
+               OpDecorate %100 Block
+        %int = OpTypeInt 32 0
+        %100 = OpTypeStruct %int
+        %200 = OpTypeStruct %int
+  )";
+
+  std::unique_ptr<IRContext> context =
+      BuildModule(SPV_ENV_UNIVERSAL_1_1, nullptr, text,
+                  SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS);
+  TypeManager manager(nullptr, context.get());
+  EXPECT_FALSE(manager.PoolHasDuplicateTypes());
+
+  // Decorating the pooled copy of %200 like %100 breaks the uniqueness of
+  // the pool.  IsSame can't see it, but the structural check does.
+  Type* type = manager.GetType(200);
+  type->AddDecoration({static_cast<uint32_t>(spv::Decoration::Block)});
+  EXPECT_FALSE(type->IsSame(manager.GetType(100)));
+  EXPECT_TRUE(manager.PoolHasDuplicateTypes());
+}
+
 TEST(TypeManager, DecorationOnStruct) {
   const std::string text = R"(
     OpDecorate %struct1 Block
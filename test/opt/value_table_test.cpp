@@ -826,6 +826,51 @@ TEST_F(ValueTableTest, DifferentDebugDeclareSameValue) {
   EXPECT_EQ(vtable.GetValueNumber(inst1), vtable.GetValueNumber(inst2));
 }
 
+TEST_F(ValueTableTest, UpdatedWhenInstructionsChange) {
+  const std::string text = R"(
+               OpCapability Shader
+          %1 = OpExtInstImport "GLSL.std.450"
+               OpMemoryModel Logical GLSL450
+               OpEntryPoint Fragment %2 "main"
+               OpExecutionMode %2 OriginUpperLeft
+               OpSource GLSL 430
+          %3 = OpTypeVoid
+          %4 = OpTypeFunction %3
+          %5 = OpTypeFloat 32
+          %6 = OpTypePointer Function %5
+          %2 = OpFunction %3 None %4
+          %7 = OpLabel
+          %8 = OpVariable %6 Function
+          %9 = OpLoad %5 %8
+         %10 = OpFAdd %5 %9 %9
+         %11 = OpFAdd %5 %9 %9
+               OpReturn
+               OpFunctionEnd
+  )";
+  auto context = BuildModule(SPV_ENV_UNIVERSAL_1_2, nullptr, text);
+  ValueNumberTable* vtable = context->GetValueNumberTable();
+  const uint32_t value = vtable->GetValueNumber(10);
+  EXPECT_NE(value, 0u);
+  EXPECT_EQ(vtable->GetValueNumber(11), value);
+
+  // Killing an instruction keeps the table valid and forgets its result.
+  context->KillInst(context->get_def_use_mgr()->GetDef(11));
+  EXPECT_TRUE(context->AreAnalysesValid(IRContext::kAnalysisValueNumberTable));
+  EXPECT_EQ(vtable->GetValueNumber(11), 0u);
+
+  // A new instruction computing the same value gets the same value number.
+  Instruction* add = context->get_def_use_mgr()->GetDef(10);
+  Instruction* new_add = add->Clone(context.get());
+  new_add->SetResultId(context->TakeNextId());
+  new_add->InsertAfter(add);
+  context->AnalyzeDefUse(new_add);
+  EXPECT_EQ(vtable->AssignValueNumber(new_add), value);
+
+  context->KillInst(add);
+  EXPECT_EQ(vtable->GetValueNumber(new_add), value);
+  EXPECT_EQ(vtable->GetValueNumber(10), 0u);
+}
+
 }  // namespace
 }  // namespace opt
 }  // namespace spvtools
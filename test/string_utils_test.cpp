@@ -186,6 +186,24 @@ TEST(CardinalToOrdinal, Test) {
   EXPECT_EQ("1225th", CardinalToOrdinal(1225));
 }
 
+TEST(EncodedStringLength, MatchesMakeString) {
+  // "abc" fits in one word with its terminator; "abcd" needs a second word.
+  const uint32_t abc[] = {0x00636261};
+  const uint32_t abcd[] = {0x64636261, 0};
+  const uint32_t empty[] = {0};
+  EXPECT_EQ(3u, EncodedStringLength(abc, 1));
+  EXPECT_EQ(MakeString(abc, 1).size(), EncodedStringLength(abc, 1));
+  EXPECT_EQ(4u, EncodedStringLength(abcd, 2));
+  EXPECT_EQ(MakeString(abcd, 2).size(), EncodedStringLength(abcd, 2));
+  EXPECT_EQ(0u, EncodedStringLength(empty, 1));
+}
+
+TEST(EncodedStringLength, MissingTerminator) {
+  const uint32_t abcd[] = {0x64636261};
+  EXPECT_EQ(4u, EncodedStringLength(abcd, 1));
+  EXPECT_EQ(0u, EncodedStringLength(abcd, 0));
+}
+
 }  // namespace
 }  // namespace utils
 }  // namespace spvtools
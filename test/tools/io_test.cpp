@@ -0,0 +1,120 @@
+// Copyright (c) 2026 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tools/io.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
+
+class MapBinaryFileTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    const ::testing::TestInfo* info =
+        ::testing::UnitTest::GetInstance()->current_test_info();
+    path_ = ::testing::TempDir() + "spirv_io_test_" + info->name();
+  }
+  void TearDown() override { std::remove(path_.c_str()); }
+
+  // Replaces the contents of the test file with |size| bytes from |data|.
+  void WriteTestFile(const void* data, size_t size) {
+    FILE* fp = fopen(path_.c_str(), "wb");
+    ASSERT_NE(nullptr, fp);
+    if (size) {
+      EXPECT_EQ(size, fwrite(data, 1, size, fp));
+    }
+    fclose(fp);
+  }
+
+  std::string path_;
+};
+
+TEST_F(MapBinaryFileTest, RegularFile) {
+  const std::vector<uint32_t> words = {0x07230203u, 0x00010000u, 42u};
+  WriteTestFile(words.data(), words.size() * sizeof(uint32_t));
+
+  InputFileContents<uint32_t> contents;
+  ASSERT_TRUE(MapBinaryFile<uint32_t>(path_.c_str(), &contents));
+  ASSERT_EQ(words.size(), contents.size());
+  EXPECT_THAT(contents.ToVector(), ElementsAreArray(words));
+
+  // Moving keeps the contents and empties the source.
+  InputFileContents<uint32_t> moved(std::move(contents));
+  EXPECT_EQ(0u, contents.size());
+  EXPECT_THAT(moved.ToVector(), ElementsAreArray(words));
+}
+
+TEST_F(MapBinaryFileTest, EmptyFile) {
+  WriteTestFile(nullptr, 0);
+
+  InputFileContents<uint32_t> contents;
+  ASSERT_TRUE(MapBinaryFile<uint32_t>(path_.c_str(), &contents));
+  EXPECT_EQ(0u, contents.size());
+}
+
+TEST_F(MapBinaryFileTest, SizeNotMultipleOfElementSize) {
+  const uint8_t bytes[] = {1, 2, 3, 4, 5, 6};
+  WriteTestFile(bytes, sizeof(bytes));
+
+  InputFileContents<uint32_t> contents;
+  EXPECT_FALSE(MapBinaryFile<uint32_t>(path_.c_str(), &contents));
+  EXPECT_EQ(0u, contents.size());
+
+  // Bytes can be read whatever the size.
+  InputFileContents<uint8_t> byte_contents;
+  ASSERT_TRUE(MapBinaryFile<uint8_t>(path_.c_str(), &byte_contents));
+  EXPECT_THAT(byte_contents.ToVector(), ElementsAre(1, 2, 3, 4, 5, 6));
+}
+
+TEST_F(MapBinaryFileTest, MissingFile) {
+  InputFileContents<uint32_t> contents;
+  EXPECT_FALSE(MapBinaryFile<uint32_t>(path_.c_str(), &contents));
+}
+
+#if defined(SPIRV_TOOLS_IO_HAS_MMAP)
+TEST_F(MapBinaryFileTest, DashReadsStandardInput) {
+  const std::vector<uint32_t> words = {0x07230203u, 0x00010000u, 42u};
+  WriteTestFile(words.data(), words.size() * sizeof(uint32_t));
+
+  // Point standard input at the test file for the duration of the read.
+  const int saved_stdin = dup(STDIN_FILENO);
+  ASSERT_GE(saved_stdin, 0);
+  const int fd = open(path_.c_str(), O_RDONLY);
+  ASSERT_GE(fd, 0);
+  ASSERT_EQ(STDIN_FILENO, dup2(fd, STDIN_FILENO));
+  close(fd);
+  clearerr(stdin);
+
+  InputFileContents<uint32_t> contents;
+  const bool read = MapBinaryFile<uint32_t>("-", &contents);
+
+  clearerr(stdin);
+  dup2(saved_stdin, STDIN_FILENO);
+  close(saved_stdin);
+
+  ASSERT_TRUE(read);
+  EXPECT_THAT(contents.ToVector(), ElementsAreArray(words));
+}
+#endif  // defined(SPIRV_TOOLS_IO_HAS_MMAP)
+
+}  // namespace
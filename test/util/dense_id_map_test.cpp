@@ -0,0 +1,90 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "source/util/dense_id_map.h"
+
+namespace spvtools {
+namespace utils {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::Pair;
+
+TEST(DenseIdMapTest, Empty) {
+  DenseIdMap<uint32_t> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(0u, map.size());
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_EQ(map.end(), map.find(1));
+  EXPECT_EQ(0u, map.count(0));
+}
+
+TEST(DenseIdMapTest, InsertFindErase) {
+  DenseIdMap<uint32_t> map;
+  EXPECT_TRUE(map.insert({5, 50}).second);
+  EXPECT_FALSE(map.insert({5, 51}).second);
+  map[3] = 30;
+  EXPECT_EQ(2u, map.size());
+  EXPECT_EQ(50u, map.at(5));
+  EXPECT_EQ(30u, map.find(3)->second);
+  EXPECT_EQ(0u, map.count(4));
+
+  EXPECT_EQ(1u, map.erase(5));
+  EXPECT_EQ(0u, map.erase(5));
+  EXPECT_EQ(map.end(), map.find(5));
+  EXPECT_EQ(1u, map.size());
+}
+
+TEST(DenseIdMapTest, IteratesInIdOrder) {
+  DenseIdMap<uint32_t> map;
+  map[9] = 90;
+  map[2] = 20;
+  map[4] = 40;
+  map.erase(4);
+  EXPECT_THAT(std::vector<std::pair<uint32_t, uint32_t>>(map.begin(),
+                                                         map.end()),
+              ElementsAre(Pair(2, 20), Pair(9, 90)));
+}
+
+TEST(DenseIdMapTest, SparseIdsDoNotGrowDenseStorage) {
+  DenseIdMap<uint32_t> map;
+  map[1] = 10;
+  map[0xFFFFFFF0] = 20;
+  map[0x80000000] = 30;
+  EXPECT_EQ(3u, map.size());
+  EXPECT_EQ(20u, map.at(0xFFFFFFF0));
+  EXPECT_EQ(30u, map.at(0x80000000));
+  EXPECT_EQ(1u, map.erase(0xFFFFFFF0));
+  EXPECT_EQ(map.end(), map.find(0xFFFFFFF0));
+  EXPECT_EQ(30u, map.at(0x80000000));
+}
+
+TEST(DenseIdMapTest, EqualityIgnoresStorage) {
+  DenseIdMap<uint32_t> grown;
+  for (uint32_t id = 1; id < 10000; ++id) grown[id] = id;
+  DenseIdMap<uint32_t> reversed;
+  for (uint32_t id = 9999; id >= 1; --id) reversed[id] = id;
+  EXPECT_EQ(grown, reversed);
+
+  reversed[5000] = 0;
+  EXPECT_NE(grown, reversed);
+}
+
+}  // namespace
+}  // namespace utils
+}  // namespace spvtools
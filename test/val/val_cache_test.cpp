@@ -0,0 +1,333 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Tests for the persistent validation cache.
+
+#include <algorithm>
+#include <cstdio>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "source/val/validation_cache.h"
+#include "test/unit_spirv.h"
+#include "test/val/val_fixtures.h"
+
+namespace spvtools {
+namespace val {
+namespace {
+
+using ::testing::HasSubstr;
+
+const char kValidModule[] = R"(
+OpCapability Shader
+OpCapability Linkage
+OpMemoryModel Logical GLSL450
+%void = OpTypeVoid
+%void_fn = OpTypeFunction %void
+%main = OpFunction %void None %void_fn
+%entry = OpLabel
+OpReturn
+OpFunctionEnd
+)";
+
+const char kInvalidModule[] = R"(
+OpCapability Shader
+OpCapability Linkage
+OpMemoryModel Logical GLSL450
+%void = OpTypeVoid
+%void_fn = OpTypeFunction %void
+%main = OpFunction %void None %void_fn
+%entry = OpLabel
+OpBranch %missing
+OpFunctionEnd
+)";
+
+class ValidateCache : public spvtest::ValidateBase<bool> {
+ public:
+  ValidateCache() : directory_(::testing::TempDir()) {
+    spvValidatorOptionsSetCacheDirectory(getValidatorOptions(),
+                                         directory_.c_str());
+    // A salt lets development builds use the cache too.
+    spvValidatorOptionsSetCacheSalt(getValidatorOptions(), "val_cache_test");
+  }
+
+  ~ValidateCache() override {
+    for (const auto& name : entries_) std::remove(EntryPath(name).c_str());
+  }
+
+  std::string EntryPath(const std::string& name) const {
+    std::string path = directory_;
+    if (!path.empty() && path.back() != '/' && path.back() != '\\') {
+      path += '/';
+    }
+    return path + name + ".spvval";
+  }
+
+  // Returns the cache key of the compiled module.
+  std::string Key(spv_target_env env = SPV_ENV_UNIVERSAL_1_0) {
+    return ValidationCacheKey(env, *getValidatorOptions(),
+                              get_const_binary()->code,
+                              get_const_binary()->wordCount);
+  }
+
+  // Returns the name of the cache entry for |key|. The first time a name is
+  // seen, any entry left behind by an earlier run is removed.
+  std::string EntryName(const std::string& key) {
+    const std::string name = ValidationCacheEntryName(key);
+    if (std::find(entries_.begin(), entries_.end(), name) == entries_.end()) {
+      entries_.push_back(name);
+      std::remove(EntryPath(name).c_str());
+    }
+    return name;
+  }
+
+  std::string ReadEntry(const std::string& name) const {
+    std::string data;
+    FILE* file = std::fopen(EntryPath(name).c_str(), "rb");
+    if (!file) return data;
+    char buffer[4096];
+    size_t count = 0;
+    while ((count = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+      data.append(buffer, count);
+    }
+    std::fclose(file);
+    return data;
+  }
+
+  void WriteEntry(const std::string& name, const std::string& data) const {
+    FILE* file = std::fopen(EntryPath(name).c_str(), "wb");
+    ASSERT_NE(nullptr, file);
+    std::fwrite(data.data(), 1, data.size(), file);
+    std::fclose(file);
+  }
+
+ protected:
+  std::string directory_;
+  std::vector<std::string> entries_;
+};
+
+bool IsDevelopmentVersion() {
+  const std::string version = spvSoftwareVersionString();
+  return version.size() >= 4 &&
+         version.compare(version.size() - 4, 4, "-dev") == 0;
+}
+
+CachedValidation MakeEntry(spv_result_t result, const std::string& message) {
+  CachedValidation entry;
+  entry.result = result;
+  spv_position_t position = {};
+  position.index = 7;
+  entry.messages.push_back({SPV_MSG_ERROR, "input", position, message});
+  return entry;
+}
+
+TEST_F(ValidateCache, StoresOutcomeOnMiss) {
+  CompileSuccessfully(kInvalidModule);
+  const std::string key = Key();
+  const std::string name = EntryName(key);
+
+  EXPECT_EQ(SPV_ERROR_INVALID_ID, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(), HasSubstr("has not been defined"));
+
+  CachedValidation entry;
+  ASSERT_TRUE(LoadValidationCacheEntry(directory_, name, key, &entry));
+  EXPECT_EQ(SPV_ERROR_INVALID_ID, entry.result);
+  ASSERT_EQ(1u, entry.messages.size());
+  EXPECT_EQ(SPV_MSG_ERROR, entry.messages[0].level);
+  EXPECT_EQ(getDiagnosticString(), entry.messages[0].message);
+
+  // The second run is served from the cache with the same diagnostic.
+  const std::string first_diagnostic = getDiagnosticString();
+  EXPECT_EQ(SPV_ERROR_INVALID_ID, ValidateInstructions());
+  EXPECT_EQ(first_diagnostic, getDiagnosticString());
+}
+
+TEST_F(ValidateCache, ReplaysCachedOutcome) {
+  CompileSuccessfully(kValidModule);
+  const std::string key = Key();
+  const std::string name = EntryName(key);
+  StoreValidationCacheEntry(
+      directory_, name, key,
+      MakeEntry(SPV_ERROR_INVALID_DATA, "cached\nmulti-line message"));
+
+  EXPECT_EQ(SPV_ERROR_INVALID_DATA, ValidateInstructions());
+  EXPECT_EQ("cached\nmulti-line message", getDiagnosticString());
+  EXPECT_EQ(7u, getErrorPosition().index);
+
+  // Without the cache the module is validated.
+  spvValidatorOptionsSetCacheDirectory(getValidatorOptions(), nullptr);
+  EXPECT_EQ(SPV_SUCCESS, ValidateInstructions());
+}
+
+TEST_F(ValidateCache, KeyDependsOnModuleAndOptions) {
+  CompileSuccessfully(kValidModule);
+  const std::string key = Key();
+  ASSERT_FALSE(key.empty());
+
+  // The number of threads doesn't change the outcome.
+  spvValidatorOptionsSetNumThreads(getValidatorOptions(), 4);
+  EXPECT_EQ(key, Key());
+
+  spvValidatorOptionsSetRelaxBlockLayout(getValidatorOptions(), true);
+  const std::string relaxed_key = Key();
+  EXPECT_NE(key, relaxed_key);
+
+  EXPECT_NE(relaxed_key, Key(SPV_ENV_VULKAN_1_0));
+
+  CompileSuccessfully(kInvalidModule);
+  EXPECT_NE(relaxed_key, Key());
+}
+
+TEST_F(ValidateCache, SaltIdentifiesTheBuild) {
+  CompileSuccessfully(kValidModule);
+  const std::string key = Key();
+  EXPECT_TRUE(ValidationCacheEnabled(*getValidatorOptions()));
+
+  spvValidatorOptionsSetCacheSalt(getValidatorOptions(), "another build");
+  EXPECT_NE(key, Key());
+  EXPECT_TRUE(ValidationCacheEnabled(*getValidatorOptions()));
+
+  // Without a salt, only a release can tell its entries from another
+  // build's.
+  spvValidatorOptionsSetCacheSalt(getValidatorOptions(), nullptr);
+  EXPECT_NE(key, Key());
+  EXPECT_EQ(!IsDevelopmentVersion(),
+            ValidationCacheEnabled(*getValidatorOptions()));
+}
+
+TEST_F(ValidateCache, UnsaltedDevelopmentBuildsDoNotUseTheCache) {
+  // Releases use the cache without a salt.
+  if (!IsDevelopmentVersion()) return;
+  CompileSuccessfully(kInvalidModule);
+  spvValidatorOptionsSetCacheSalt(getValidatorOptions(), nullptr);
+  const std::string key = Key();
+  const std::string name = EntryName(key);
+  StoreValidationCacheEntry(directory_, name, key,
+                            MakeEntry(SPV_SUCCESS, "cached"));
+
+  // The entry is ignored and nothing is written over it.
+  EXPECT_EQ(SPV_ERROR_INVALID_ID, ValidateInstructions());
+  CachedValidation entry;
+  ASSERT_TRUE(LoadValidationCacheEntry(directory_, name, key, &entry));
+  EXPECT_EQ(SPV_SUCCESS, entry.result);
+}
+
+TEST_F(ValidateCache, KeyHoldsTheWholeModule) {
+  CompileSuccessfully(kValidModule);
+  const std::string key = Key();
+  const size_t module_size =
+      get_const_binary()->wordCount * sizeof(uint32_t);
+  ASSERT_GT(key.size(), module_size);
+
+  // Flipping any one bit of the module changes the key.
+  std::vector<uint32_t> words(
+      get_const_binary()->code,
+      get_const_binary()->code + get_const_binary()->wordCount);
+  for (size_t i = 0; i < words.size(); ++i) {
+    words[i] ^= 1u << (i % 32);
+    EXPECT_NE(key, ValidationCacheKey(SPV_ENV_UNIVERSAL_1_0,
+                                      *getValidatorOptions(), words.data(),
+                                      words.size()));
+    words[i] ^= 1u << (i % 32);
+  }
+}
+
+TEST_F(ValidateCache, LargeModulesAreNotCached) {
+  const std::vector<uint32_t> words((4 << 20) / sizeof(uint32_t), 0);
+  EXPECT_EQ("", ValidationCacheKey(SPV_ENV_UNIVERSAL_1_0,
+                                   *getValidatorOptions(), words.data(),
+                                   words.size()));
+}
+
+TEST_F(ValidateCache, EntryNamesAreBounded) {
+  std::set<std::string> names;
+  for (uint32_t i = 0; i < 10000; ++i) {
+    names.insert(ValidationCacheEntryName("key " + std::to_string(i)));
+  }
+  EXPECT_LE(names.size(), 1024u);
+  EXPECT_GT(names.size(), 512u);
+}
+
+TEST_F(ValidateCache, IgnoresEntryForAnotherKey) {
+  CompileSuccessfully(kValidModule);
+  const std::string key = Key();
+  const std::string name = EntryName(key);
+
+  // Another key stored under the same name, as when two keys share a name.
+  std::string other_key = key;
+  other_key.back() = static_cast<char>(other_key.back() ^ 1);
+  StoreValidationCacheEntry(directory_, name, other_key,
+                            MakeEntry(SPV_ERROR_INVALID_DATA, "other"));
+
+  CachedValidation entry;
+  ASSERT_TRUE(LoadValidationCacheEntry(directory_, name, other_key, &entry));
+  EXPECT_FALSE(LoadValidationCacheEntry(directory_, name, key, &entry));
+  EXPECT_FALSE(LoadValidationCacheEntry(directory_, name,
+                                        key.substr(0, key.size() - 1), &entry));
+  EXPECT_EQ(SPV_SUCCESS, ValidateInstructions());
+}
+
+TEST_F(ValidateCache, IgnoresTruncatedOrExtendedEntry) {
+  CompileSuccessfully(kValidModule);
+  const std::string key = Key();
+  const std::string name = EntryName(key);
+  StoreValidationCacheEntry(directory_, name, key,
+                            MakeEntry(SPV_ERROR_INVALID_DATA, "cached"));
+  const std::string data = ReadEntry(name);
+  ASSERT_FALSE(data.empty());
+
+  CachedValidation entry;
+  EXPECT_TRUE(LoadValidationCacheEntry(directory_, name, key, &entry));
+
+  WriteEntry(name, data.substr(0, data.size() - 1));
+  EXPECT_FALSE(LoadValidationCacheEntry(directory_, name, key, &entry));
+
+  WriteEntry(name, data + "\n");
+  EXPECT_FALSE(LoadValidationCacheEntry(directory_, name, key, &entry));
+  EXPECT_EQ(SPV_SUCCESS, ValidateInstructions());
+}
+
+TEST_F(ValidateCache, IgnoresEntryInAnotherFormat) {
+  CompileSuccessfully(kValidModule);
+  const std::string key = Key();
+  const std::string name = EntryName(key);
+  StoreValidationCacheEntry(directory_, name, key,
+                            MakeEntry(SPV_ERROR_INVALID_DATA, "cached"));
+  std::string data = ReadEntry(name);
+  const std::string header = "spirv-val cache 2 ";
+  ASSERT_EQ(0u, data.compare(0, header.size(), header));
+
+  data.replace(0, header.size(), "spirv-val cache 3 ");
+  WriteEntry(name, data);
+  CachedValidation entry;
+  EXPECT_FALSE(LoadValidationCacheEntry(directory_, name, key, &entry));
+  EXPECT_EQ(SPV_SUCCESS, ValidateInstructions());
+}
+
+TEST_F(ValidateCache, IgnoresMalformedEntry) {
+  CompileSuccessfully(kValidModule);
+  const std::string key = Key();
+  const std::string name = EntryName(key);
+  WriteEntry(name, "spirv-val cache 2 5\n-3 2\n");
+
+  CachedValidation entry;
+  EXPECT_FALSE(LoadValidationCacheEntry(directory_, name, key, &entry));
+  EXPECT_EQ(SPV_SUCCESS, ValidateInstructions());
+}
+
+}  // namespace
+}  // namespace val
+}  // namespace spvtools
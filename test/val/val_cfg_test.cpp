@@ -14,6 +14,7 @@
 
 // Validation tests for Control Flow Graph
 
+#include <algorithm>
 #include <array>
 #include <functional>
 #include <sstream>
@@ -5118,6 +5119,57 @@ OpFunctionEnd
   EXPECT_EQ(SPV_SUCCESS, ValidateInstructions());
 }
 
+// Returns a module with |num_functions| functions. Each one listed in
+// |bad_functions| has a block that appears before its dominator.
+std::string MultiFunctionModule(int num_functions,
+                                const std::vector<int>& bad_functions) {
+  std::string names;
+  std::string functions;
+  for (int i = 0; i < num_functions; ++i) {
+    const std::string n = std::to_string(i);
+    names += "OpName %cont" + n + " \"cont" + n + "\"\n";
+    names += "OpName %branch" + n + " \"branch" + n + "\"\n";
+    const bool bad = std::find(bad_functions.begin(), bad_functions.end(),
+                               i) != bad_functions.end();
+    const std::string cont = "%cont" + n + " = OpLabel\nOpBranch %merge" + n +
+                             "\n";
+    const std::string branch = "%branch" + n +
+                               " = OpLabel\nOpSelectionMerge %merge" + n +
+                               " None\nOpBranchConditional %true %cont" + n +
+                               " %merge" + n + "\n";
+    functions += "%func" + n + " = OpFunction %void None %fn\n";
+    functions += "%entry" + n + " = OpLabel\nOpBranch %branch" + n + "\n";
+    functions += bad ? cont + branch : branch + cont;
+    functions += "%merge" + n + " = OpLabel\nOpReturn\nOpFunctionEnd\n";
+  }
+  return R"(
+OpCapability Shader
+OpCapability Linkage
+OpMemoryModel Logical GLSL450
+)" + names + R"(
+%void = OpTypeVoid
+%fn = OpTypeFunction %void
+%bool = OpTypeBool
+%true = OpConstantTrue %bool
+)" + functions;
+}
+
+TEST_F(ValidateCFG, ThreadedCfgChecksAcceptValidModule) {
+  CompileSuccessfully(MultiFunctionModule(16, {}));
+  spvValidatorOptionsSetNumThreads(getValidatorOptions(), 4);
+  EXPECT_EQ(SPV_SUCCESS, ValidateInstructions());
+}
+
+TEST_F(ValidateCFG, ThreadedCfgChecksReportFirstFailingFunction) {
+  CompileSuccessfully(MultiFunctionModule(16, {5, 9, 14}));
+  spvValidatorOptionsSetNumThreads(getValidatorOptions(), 4);
+  ASSERT_EQ(SPV_ERROR_INVALID_CFG, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("[%cont5]' appears in the binary before its "
+                        "dominator"));
+  EXPECT_THAT(getDiagnosticString(), HasSubstr("[%branch5]'"));
+}
+
 }  // namespace
 }  // namespace val
 }  // namespace spvtools
@@ -28,6 +28,7 @@ namespace val {
 namespace {
 
 using ::testing::Combine;
+using ::testing::ElementsAreArray;
 using ::testing::Eq;
 using ::testing::HasSubstr;
 using ::testing::Values;
@@ -61,10 +62,10 @@ TEST_F(ValidateDecorations, ValidateOpDecorateRegistration) {
   CompileSuccessfully(spirv);
   EXPECT_EQ(SPV_SUCCESS, ValidateAndRetrieveValidationState());
   // Must have 2 decorations.
-  EXPECT_THAT(
-      vstate_->id_decorations(id),
-      Eq(std::set<Decoration>{Decoration(spv::Decoration::Location, {4}),
-                              Decoration(spv::Decoration::Centroid)}));
+  EXPECT_THAT(vstate_->id_decorations(id),
+              ElementsAreArray(std::set<Decoration>{
+                  Decoration(spv::Decoration::Location, {4}),
+                  Decoration(spv::Decoration::Centroid)}));
 }
 
 TEST_F(ValidateDecorations, ValidateOpMemberDecorateRegistration) {
@@ -87,17 +88,17 @@ TEST_F(ValidateDecorations, ValidateOpMemberDecorateRegistration) {
 
   // The array must have 1 decoration.
   const uint32_t arr_id = 1;
-  EXPECT_THAT(
-      vstate_->id_decorations(arr_id),
-      Eq(std::set<Decoration>{Decoration(spv::Decoration::ArrayStride, {4})}));
+  EXPECT_THAT(vstate_->id_decorations(arr_id),
+              ElementsAreArray(std::set<Decoration>{
+                  Decoration(spv::Decoration::ArrayStride, {4})}));
 
   // The struct must have 3 decorations.
   const uint32_t struct_id = 2;
-  EXPECT_THAT(
-      vstate_->id_decorations(struct_id),
-      Eq(std::set<Decoration>{Decoration(spv::Decoration::NonReadable, {}, 2),
-                              Decoration(spv::Decoration::Offset, {2}, 2),
-                              Decoration(spv::Decoration::BufferBlock)}));
+  EXPECT_THAT(vstate_->id_decorations(struct_id),
+              ElementsAreArray(std::set<Decoration>{
+                  Decoration(spv::Decoration::NonReadable, {}, 2),
+                  Decoration(spv::Decoration::Offset, {2}, 2),
+                  Decoration(spv::Decoration::BufferBlock)}));
 }
 
 TEST_F(ValidateDecorations, ValidateOpMemberDecorateOutOfBound) {
@@ -158,10 +159,14 @@ TEST_F(ValidateDecorations, ValidateGroupDecorateRegistration) {
 
   // Decoration group is applied to id 1, 2, 3, and 4. Note that id 1 (which is
   // the decoration group id) also has all the decorations.
-  EXPECT_THAT(vstate_->id_decorations(1), Eq(expected_decorations));
-  EXPECT_THAT(vstate_->id_decorations(2), Eq(expected_decorations));
-  EXPECT_THAT(vstate_->id_decorations(3), Eq(expected_decorations));
-  EXPECT_THAT(vstate_->id_decorations(4), Eq(expected_decorations));
+  EXPECT_THAT(vstate_->id_decorations(1),
+              ElementsAreArray(expected_decorations));
+  EXPECT_THAT(vstate_->id_decorations(2),
+              ElementsAreArray(expected_decorations));
+  EXPECT_THAT(vstate_->id_decorations(3),
+              ElementsAreArray(expected_decorations));
+  EXPECT_THAT(vstate_->id_decorations(4),
+              ElementsAreArray(expected_decorations));
 }
 
 TEST_F(ValidateDecorations, ValidateGroupMemberDecorateRegistration) {
@@ -185,9 +190,159 @@ TEST_F(ValidateDecorations, ValidateGroupMemberDecorateRegistration) {
       std::set<Decoration>{Decoration(spv::Decoration::Offset, {3}, 3)};
 
   // Decoration group is applied to id 2, 3, and 4.
-  EXPECT_THAT(vstate_->id_decorations(2), Eq(expected_decorations));
-  EXPECT_THAT(vstate_->id_decorations(3), Eq(expected_decorations));
-  EXPECT_THAT(vstate_->id_decorations(4), Eq(expected_decorations));
+  EXPECT_THAT(vstate_->id_decorations(2),
+              ElementsAreArray(expected_decorations));
+  EXPECT_THAT(vstate_->id_decorations(3),
+              ElementsAreArray(expected_decorations));
+  EXPECT_THAT(vstate_->id_decorations(4),
+              ElementsAreArray(expected_decorations));
+}
+
+TEST(DecorationSetTest, KeepsDecorationsSortedWithoutDuplicates) {
+  const Decoration location(spv::Decoration::Location, {4});
+  const Decoration flat(spv::Decoration::Flat);
+  const Decoration member_offset(spv::Decoration::Offset, {8}, 1);
+  const Decoration member_builtin(spv::Decoration::BuiltIn, {0}, 0);
+
+  DecorationSet decorations;
+  EXPECT_TRUE(decorations.empty());
+  EXPECT_TRUE(decorations.insert(member_offset).second);
+  EXPECT_TRUE(decorations.insert(location).second);
+  EXPECT_TRUE(decorations.insert(member_builtin).second);
+  EXPECT_TRUE(decorations.insert(flat).second);
+  EXPECT_FALSE(decorations.insert(location).second);
+  EXPECT_FALSE(decorations.insert(member_offset).second);
+
+  // Decorations of the <id> itself come first, then those of each member.
+  EXPECT_EQ(4u, decorations.size());
+  EXPECT_THAT(decorations,
+              ElementsAreArray(std::vector<Decoration>{
+                  location, flat, member_builtin, member_offset}));
+}
+
+TEST(DecorationSetTest, InsertRangeSkipsDuplicates) {
+  const std::vector<Decoration> input = {
+      Decoration(spv::Decoration::Restrict),
+      Decoration(spv::Decoration::DescriptorSet, {0}),
+      Decoration(spv::Decoration::Restrict),
+      Decoration(spv::Decoration::DescriptorSet, {1}),
+  };
+  DecorationSet decorations;
+  decorations.insert(input.begin(), input.end());
+  EXPECT_THAT(decorations,
+              ElementsAreArray(std::vector<Decoration>{
+                  Decoration(spv::Decoration::DescriptorSet, {0}),
+                  Decoration(spv::Decoration::DescriptorSet, {1}),
+                  Decoration(spv::Decoration::Restrict)}));
+}
+
+TEST(DecorationSetTest, FindsDecorationsAndMemberRanges) {
+  DecorationSet decorations;
+  decorations.insert(Decoration(spv::Decoration::Block));
+  decorations.insert(Decoration(spv::Decoration::Offset, {0}, 0));
+  decorations.insert(Decoration(spv::Decoration::Offset, {16}, 1));
+  decorations.insert(Decoration(spv::Decoration::NonWritable, {}, 1));
+  decorations.insert(Decoration(spv::Decoration::Offset, {32}, 2));
+
+  const Decoration offset_1(spv::Decoration::Offset, {16}, 1);
+  ASSERT_NE(decorations.end(), decorations.find(offset_1));
+  EXPECT_TRUE(*decorations.find(offset_1) == offset_1);
+  EXPECT_EQ(1u, decorations.count(offset_1));
+  EXPECT_EQ(decorations.end(),
+            decorations.find(Decoration(spv::Decoration::Offset, {16}, 2)));
+  EXPECT_EQ(0u, decorations.count(Decoration(spv::Decoration::Offset, {16})));
+
+  const auto begin = decorations.lower_bound(
+      Decoration(static_cast<spv::Decoration>(0), {}, 1));
+  const auto end =
+      decorations.upper_bound(Decoration(spv::Decoration::Max, {}, 1));
+  EXPECT_THAT(std::vector<Decoration>(begin, end),
+              ElementsAreArray(std::vector<Decoration>{
+                  Decoration(spv::Decoration::Offset, {16}, 1),
+                  Decoration(spv::Decoration::NonWritable, {}, 1)}));
+}
+
+TEST(DecorationSetTest, HasDecorationType) {
+  DecorationSet decorations;
+  EXPECT_FALSE(decorations.HasDecorationType(spv::Decoration::BuiltIn));
+
+  decorations.insert(Decoration(spv::Decoration::Location, {0}));
+  decorations.insert(Decoration(spv::Decoration::BuiltIn, {0}, 3));
+  EXPECT_TRUE(decorations.HasDecorationType(spv::Decoration::Location));
+  // Member decorations count too.
+  EXPECT_TRUE(decorations.HasDecorationType(spv::Decoration::BuiltIn));
+  EXPECT_FALSE(decorations.HasDecorationType(spv::Decoration::Offset));
+
+  // A type sharing a summary bit with a present type is still told apart.
+  const auto aliased_location = static_cast<spv::Decoration>(
+      static_cast<uint32_t>(spv::Decoration::Location) + 64);
+  EXPECT_FALSE(decorations.HasDecorationType(aliased_location));
+  decorations.insert(Decoration(aliased_location));
+  EXPECT_TRUE(decorations.HasDecorationType(aliased_location));
+}
+
+TEST_F(ValidateDecorations, BuiltInDecoratedIdsAreSortedAndUnique) {
+  std::string spirv = R"(
+               OpCapability Shader
+               OpMemoryModel Logical GLSL450
+               OpEntryPoint Vertex %main "main" %color_in %outputs %vert_id
+               OpMemberDecorate %gl_PerVertex 0 BuiltIn Position
+               OpMemberDecorate %gl_PerVertex 1 BuiltIn PointSize
+               OpDecorate %gl_PerVertex Block
+               OpDecorate %vert_id BuiltIn VertexIndex
+               OpDecorate %color_in Location 0
+       %void = OpTypeVoid
+         %fn = OpTypeFunction %void
+      %float = OpTypeFloat 32
+        %int = OpTypeInt 32 1
+    %v4float = OpTypeVector %float 4
+%gl_PerVertex = OpTypeStruct %v4float %float
+%ptr_Output_gl_PerVertex = OpTypePointer Output %gl_PerVertex
+    %outputs = OpVariable %ptr_Output_gl_PerVertex Output
+%ptr_Input_int = OpTypePointer Input %int
+    %vert_id = OpVariable %ptr_Input_int Input
+%ptr_Input_v4float = OpTypePointer Input %v4float
+   %color_in = OpVariable %ptr_Input_v4float Input
+       %main = OpFunction %void None %fn
+      %entry = OpLabel
+               OpReturn
+               OpFunctionEnd
+  )";
+  CompileSuccessfully(spirv);
+  EXPECT_EQ(SPV_SUCCESS, ValidateAndRetrieveValidationState())
+      << getDiagnosticString();
+
+  // %color_in is id 2, %vert_id id 4 and %gl_PerVertex id 5. The struct is
+  // decorated first, and carries two BuiltIn member decorations, but is listed
+  // once and after %vert_id. %color_in only has a Location, so it is not
+  // listed.
+  EXPECT_THAT(vstate_->builtin_decorated_ids(),
+              ElementsAreArray(std::vector<uint32_t>{4, 5}));
+  EXPECT_TRUE(vstate_->HasDecoration(4, spv::Decoration::BuiltIn));
+  EXPECT_TRUE(vstate_->HasDecoration(5, spv::Decoration::BuiltIn));
+  EXPECT_FALSE(vstate_->HasDecoration(2, spv::Decoration::BuiltIn));
+}
+
+TEST_F(ValidateDecorations, BuiltInDecoratedIdsIncludeGroupTargets) {
+  std::string spirv = R"(
+               OpCapability Shader
+               OpCapability Linkage
+               OpMemoryModel Logical GLSL450
+               OpDecorate %group BuiltIn VertexIndex
+      %group = OpDecorationGroup
+               OpGroupDecorate %group %var_b %var_a
+        %int = OpTypeInt 32 1
+%ptr_Input_int = OpTypePointer Input %int
+      %var_a = OpVariable %ptr_Input_int Input
+      %var_b = OpVariable %ptr_Input_int Input
+  )";
+  CompileSuccessfully(spirv);
+  ASSERT_EQ(SPV_SUCCESS, ValidateAndRetrieveValidationState())
+      << getDiagnosticString();
+
+  // %group is id 1, %var_b id 2 and %var_a id 3.
+  EXPECT_THAT(vstate_->builtin_decorated_ids(),
+              ElementsAreArray(std::vector<uint32_t>{1, 2, 3}));
 }
 
 TEST_F(ValidateDecorations, LinkageImportUsedForInitializedVariableBad) {
@@ -9444,6 +9599,174 @@ OpFunctionEnd
           "contains an array with stride 0, but with an element size of 4"));
 }
 
+TEST_F(ValidateDecorations, PhysicalStorageBufferArrayOfStructsMatrixStride) {
+  // Member constraints of structs inside an array pointed to by a
+  // PhysicalStorageBuffer pointer come from their decorations.
+  const std::string spirv = R"(
+OpCapability Shader
+OpCapability Int64
+OpCapability PhysicalStorageBufferAddresses
+OpMemoryModel PhysicalStorageBuffer64 GLSL450
+OpEntryPoint GLCompute %main "main" %pc
+OpExecutionMode %main LocalSize 1 1 1
+OpDecorate %pc_block Block
+OpMemberDecorate %pc_block 0 Offset 0
+OpMemberDecorate %pssbo_struct 0 Offset 0
+OpMemberDecorate %pssbo_struct 0 ColMajor
+OpMemberDecorate %pssbo_struct 0 MatrixStride 4
+OpDecorate %pssbo_array ArrayStride 16
+%void = OpTypeVoid
+%long = OpTypeInt 64 0
+%float = OpTypeFloat 32
+%v2float = OpTypeVector %float 2
+%mat2v2float = OpTypeMatrix %v2float 2
+%int = OpTypeInt 32 0
+%int_0 = OpConstant %int 0
+%int_4 = OpConstant %int 4
+%pc_block = OpTypeStruct %long
+%pc_block_ptr = OpTypePointer PushConstant %pc_block
+%pc_long_ptr = OpTypePointer PushConstant %long
+%pc = OpVariable %pc_block_ptr PushConstant
+%pssbo_struct = OpTypeStruct %mat2v2float
+%pssbo_array = OpTypeArray %pssbo_struct %int_4
+%pssbo_ptr = OpTypePointer PhysicalStorageBuffer %pssbo_array
+%void_fn = OpTypeFunction %void
+%main = OpFunction %void None %void_fn
+%entry = OpLabel
+%pc_gep = OpAccessChain %pc_long_ptr %pc %int_0
+%addr = OpLoad %long %pc_gep
+%ptr = OpConvertUToPtr %pssbo_ptr %addr
+OpReturn
+OpFunctionEnd
+)";
+
+  CompileSuccessfully(spirv, SPV_ENV_VULKAN_1_3);
+  EXPECT_EQ(SPV_ERROR_INVALID_ID, ValidateInstructions(SPV_ENV_VULKAN_1_3));
+  EXPECT_THAT(
+      getDiagnosticString(),
+      HasSubstr("decorated as Block for variable in PhysicalStorageBuffer "
+                "storage class must follow relaxed storage buffer layout "
+                "rules: member 0 is a matrix with stride 4 not satisfying "
+                "alignment to 8"));
+
+  // The same module is valid with a matrix stride of 8.
+  std::string fixed = spirv;
+  const std::string bad_stride = "0 MatrixStride 4";
+  fixed.replace(fixed.find(bad_stride), bad_stride.size(), "0 MatrixStride 8");
+  CompileSuccessfully(fixed, SPV_ENV_VULKAN_1_3);
+  EXPECT_EQ(SPV_SUCCESS, ValidateInstructions(SPV_ENV_VULKAN_1_3))
+      << getDiagnosticString();
+}
+
+TEST_F(ValidateDecorations, SharedMatrixTypeWithDifferentLayoutsGood) {
+  // The same matrix type is row major in the first block, where it occupies
+  // 56 bytes, and column major in the second one, where it occupies 32 bytes.
+  // Layouts computed for one block must not be reused for the other.
+  const std::string spirv = R"(
+               OpCapability Shader
+               OpMemoryModel Logical GLSL450
+               OpEntryPoint Vertex %main "main"
+               OpSource GLSL 450
+               OpMemberDecorate %row_block 0 Offset 0
+               OpMemberDecorate %row_block 0 RowMajor
+               OpMemberDecorate %row_block 0 MatrixStride 16
+               OpMemberDecorate %row_block 1 Offset 56
+               OpMemberDecorate %col_block 0 Offset 0
+               OpMemberDecorate %col_block 0 ColMajor
+               OpMemberDecorate %col_block 0 MatrixStride 16
+               OpMemberDecorate %col_block 1 Offset 32
+               OpDecorate %row_block Block
+               OpDecorate %col_block Block
+               OpDecorate %row_var DescriptorSet 0
+               OpDecorate %row_var Binding 0
+               OpDecorate %col_var DescriptorSet 0
+               OpDecorate %col_var Binding 1
+       %void = OpTypeVoid
+    %void_fn = OpTypeFunction %void
+      %float = OpTypeFloat 32
+    %v4float = OpTypeVector %float 4
+%mat2v4float = OpTypeMatrix %v4float 2
+  %row_block = OpTypeStruct %mat2v4float %float
+  %col_block = OpTypeStruct %mat2v4float %float
+    %row_ptr = OpTypePointer Uniform %row_block
+    %col_ptr = OpTypePointer Uniform %col_block
+    %row_var = OpVariable %row_ptr Uniform
+    %col_var = OpVariable %col_ptr Uniform
+       %main = OpFunction %void None %void_fn
+      %entry = OpLabel
+               OpReturn
+               OpFunctionEnd
+)";
+
+  CompileSuccessfully(spirv, SPV_ENV_VULKAN_1_0);
+  EXPECT_EQ(SPV_SUCCESS, ValidateInstructions(SPV_ENV_VULKAN_1_0))
+      << getDiagnosticString();
+}
+
+// Returns a module with the struct %inner shared by a Block in Uniform storage
+// and a BufferBlock, placed at the given offsets in each. The variable of the
+// BufferBlock comes first if |buffer_first| is true.
+std::string SharedStructInBlockAndBufferBlock(uint32_t block_offset,
+                                              uint32_t buffer_offset,
+                                              bool buffer_first) {
+  const std::string block_var = "%block_var = OpVariable %block_ptr Uniform\n";
+  const std::string buffer_var =
+      "%buffer_var = OpVariable %buffer_ptr Uniform\n";
+  return R"(
+OpCapability Shader
+OpMemoryModel Logical GLSL450
+OpEntryPoint Vertex %main "main"
+OpMemberDecorate %inner 0 Offset 0
+OpMemberDecorate %block 0 Offset 0
+OpMemberDecorate %block 1 Offset )" +
+         std::to_string(block_offset) + R"(
+OpMemberDecorate %buffer 0 Offset 0
+OpMemberDecorate %buffer 1 Offset )" +
+         std::to_string(buffer_offset) + R"(
+OpDecorate %block Block
+OpDecorate %buffer BufferBlock
+OpDecorate %block_var DescriptorSet 0
+OpDecorate %block_var Binding 0
+OpDecorate %buffer_var DescriptorSet 0
+OpDecorate %buffer_var Binding 1
+%void = OpTypeVoid
+%void_fn = OpTypeFunction %void
+%float = OpTypeFloat 32
+%inner = OpTypeStruct %float
+%block = OpTypeStruct %float %inner
+%buffer = OpTypeStruct %float %inner
+%block_ptr = OpTypePointer Uniform %block
+%buffer_ptr = OpTypePointer Uniform %buffer
+)" + (buffer_first ? buffer_var + block_var : block_var + buffer_var) +
+         R"(
+%main = OpFunction %void None %void_fn
+%entry = OpLabel
+OpReturn
+OpFunctionEnd
+)";
+}
+
+TEST_F(ValidateDecorations, SharedStructInBlockAndBufferBlockGood) {
+  // The extended alignment of %inner computed for the Block is not used for
+  // the BufferBlock, where it is only aligned to 4 bytes.
+  CompileSuccessfully(SharedStructInBlockAndBufferBlock(16, 4, false),
+                      SPV_ENV_VULKAN_1_0);
+  EXPECT_EQ(SPV_SUCCESS, ValidateInstructions(SPV_ENV_VULKAN_1_0))
+      << getDiagnosticString();
+}
+
+TEST_F(ValidateDecorations, SharedStructInBlockAndBufferBlockBad) {
+  // The alignment of %inner computed for the BufferBlock is not used for the
+  // Block, where it must be aligned to 16 bytes.
+  CompileSuccessfully(SharedStructInBlockAndBufferBlock(4, 4, true),
+                      SPV_ENV_VULKAN_1_0);
+  EXPECT_EQ(SPV_ERROR_INVALID_ID, ValidateInstructions(SPV_ENV_VULKAN_1_0));
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("decorated as Block for variable in Uniform storage "
+                        "class must follow standard uniform buffer layout "
+                        "rules: member 1 at offset 4 is not aligned to 16"));
+}
+
 }  // namespace
 }  // namespace val
 }  // namespace spvtools
@@ -0,0 +1,308 @@
+// Copyright (c) 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Tests for the dispatching of instruction checks by opcode, and for opcodes
+// that are checked by more than one validator pass.
+
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "source/val/instruction_check_dispatcher.h"
+#include "source/val/validation_state.h"
+#include "test/unit_spirv.h"
+#include "test/val/val_fixtures.h"
+
+namespace spvtools {
+namespace val {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+using ::testing::IsEmpty;
+
+// The names of the checks run, in the order they were run.
+std::vector<std::string> checks_run;
+
+// Runs each check unmeasured, recording its name.
+struct RecordingReport {
+  template <typename Stage>
+  spv_result_t Measure(const char* name, size_t, Stage&& stage) {
+    checks_run.push_back(name);
+    return stage();
+  }
+};
+
+spv_result_t Succeed(ValidationState_t&, const Instruction*) {
+  return SPV_SUCCESS;
+}
+
+spv_result_t Fail(ValidationState_t&, const Instruction*) {
+  return SPV_ERROR_INVALID_DATA;
+}
+
+bool IsNop(spv::Op opcode) { return opcode == spv::Op::OpNop; }
+
+bool IsNopOrUndef(spv::Op opcode) {
+  return opcode == spv::Op::OpNop || opcode == spv::Op::OpUndef;
+}
+
+class InstructionCheckDispatcherTest : public spvtest::ValidateBase<bool> {
+ protected:
+  void SetUp() override {
+    checks_run.clear();
+    CompileSuccessfully(
+        "OpCapability Shader OpCapability Linkage "
+        "OpMemoryModel Logical GLSL450");
+    ASSERT_EQ(SPV_SUCCESS, ValidateAndRetrieveValidationState());
+  }
+
+  // Returns a one word instruction with the given opcode.
+  Instruction MakeInstruction(uint32_t opcode) {
+    word_ = opcode | (1u << 16);
+    const spv_parsed_instruction_t parsed = {&word_,
+                                             1,
+                                             static_cast<uint16_t>(opcode),
+                                             SPV_EXT_INST_TYPE_NONE,
+                                             0,
+                                             0,
+                                             nullptr,
+                                             0};
+    return Instruction(&parsed);
+  }
+
+  template <size_t N>
+  spv_result_t Run(const InstructionCheck (&checks)[N], uint32_t opcode) {
+    const InstructionCheckDispatcher dispatcher(checks);
+    const Instruction inst = MakeInstruction(opcode);
+    RecordingReport report;
+    return dispatcher.Run(*vstate_, &inst, &report);
+  }
+
+ private:
+  uint32_t word_ = 0;
+};
+
+TEST_F(InstructionCheckDispatcherTest, RunsApplicableChecksInListedOrder) {
+  const InstructionCheck checks[] = {
+      {Succeed, nullptr, "all_first"},
+      {Succeed, IsNop, "nop"},
+      {Succeed, IsNopOrUndef, "nop_or_undef"},
+      {Succeed, nullptr, "all_last"},
+  };
+  EXPECT_EQ(SPV_SUCCESS, Run(checks, uint32_t(spv::Op::OpNop)));
+  EXPECT_THAT(checks_run,
+              ElementsAre("all_first", "nop", "nop_or_undef", "all_last"));
+}
+
+TEST_F(InstructionCheckDispatcherTest, SkipsChecksRejectingTheOpcode) {
+  const InstructionCheck checks[] = {
+      {Succeed, nullptr, "all_first"},
+      {Succeed, IsNop, "nop"},
+      {Succeed, IsNopOrUndef, "nop_or_undef"},
+      {Succeed, nullptr, "all_last"},
+  };
+  EXPECT_EQ(SPV_SUCCESS, Run(checks, uint32_t(spv::Op::OpUndef)));
+  EXPECT_THAT(checks_run, ElementsAre("all_first", "nop_or_undef", "all_last"));
+
+  checks_run.clear();
+  EXPECT_EQ(SPV_SUCCESS, Run(checks, uint32_t(spv::Op::OpLabel)));
+  EXPECT_THAT(checks_run, ElementsAre("all_first", "all_last"));
+}
+
+TEST_F(InstructionCheckDispatcherTest, RunsNoChecksWhenNoneApply) {
+  const InstructionCheck checks[] = {
+      {Fail, IsNop, "nop"},
+  };
+  EXPECT_EQ(SPV_SUCCESS, Run(checks, uint32_t(spv::Op::OpLabel)));
+  EXPECT_THAT(checks_run, IsEmpty());
+}
+
+TEST_F(InstructionCheckDispatcherTest, StopsAtFirstFailingCheck) {
+  const InstructionCheck checks[] = {
+      {Succeed, IsNop, "nop"},
+      {Fail, IsNopOrUndef, "nop_or_undef"},
+      {Succeed, nullptr, "all"},
+  };
+  EXPECT_EQ(SPV_ERROR_INVALID_DATA, Run(checks, uint32_t(spv::Op::OpNop)));
+  EXPECT_THAT(checks_run, ElementsAre("nop", "nop_or_undef"));
+}
+
+TEST_F(InstructionCheckDispatcherTest, RunsEveryCheckOnUnindexedOpcodes) {
+  const InstructionCheck checks[] = {
+      {Succeed, nullptr, "all"},
+      {Succeed, IsNop, "nop"},
+      {Succeed, IsNopOrUndef, "nop_or_undef"},
+  };
+  const uint32_t opcode = InstructionCheckDispatcher::kNumIndexedOpcodes;
+  EXPECT_EQ(SPV_SUCCESS, Run(checks, opcode));
+  EXPECT_THAT(checks_run, ElementsAre("all", "nop", "nop_or_undef"));
+
+  checks_run.clear();
+  EXPECT_EQ(SPV_SUCCESS, Run(checks, 0xffff));
+  EXPECT_THAT(checks_run, ElementsAre("all", "nop", "nop_or_undef"));
+}
+
+TEST_F(InstructionCheckDispatcherTest, FailsOnUnindexedOpcodes) {
+  const InstructionCheck checks[] = {
+      {Succeed, IsNop, "nop"},
+      {Fail, IsNop, "failing_nop"},
+      {Succeed, nullptr, "all"},
+  };
+  const uint32_t opcode = InstructionCheckDispatcher::kNumIndexedOpcodes + 1;
+  EXPECT_EQ(SPV_ERROR_INVALID_DATA, Run(checks, opcode));
+  EXPECT_THAT(checks_run, ElementsAre("nop", "failing_nop"));
+}
+
+TEST_F(InstructionCheckDispatcherTest, IndexesLastOpcodeInTable) {
+  const InstructionCheck checks[] = {
+      {Succeed, nullptr, "all"},
+      {Fail, IsNop, "nop"},
+  };
+  const uint32_t opcode = InstructionCheckDispatcher::kNumIndexedOpcodes - 1;
+  EXPECT_EQ(SPV_SUCCESS, Run(checks, opcode));
+  EXPECT_THAT(checks_run, ElementsAre("all"));
+}
+
+// The following tests make sure opcodes checked by several validator passes
+// still reach each of them through the dispatch tables.
+
+using ValidateMultiPassOpcodes = spvtest::ValidateBase<bool>;
+
+std::string DerivativeShader(const std::string& execution_model) {
+  std::string mode;
+  if (execution_model == "Fragment") {
+    mode = "OpExecutionMode %main OriginUpperLeft\n";
+  }
+  return R"(
+OpCapability Shader
+OpCapability DerivativeControl
+OpMemoryModel Logical GLSL450
+OpEntryPoint )" +
+         execution_model + R"( %main "main" %input
+)" + mode + R"(
+%void = OpTypeVoid
+%func = OpTypeFunction %void
+%f32 = OpTypeFloat 32
+%u32 = OpTypeInt 32 0
+%f32_ptr_input = OpTypePointer Input %f32
+%input = OpVariable %f32_ptr_input Input
+%main = OpFunction %void None %func
+%entry = OpLabel
+%x = OpLoad %f32 %input
+%dx = OpDPdx %f32 %x
+OpReturn
+OpFunctionEnd
+)";
+}
+
+TEST_F(ValidateMultiPassOpcodes, DerivativeLimitationCheckedAtFunction) {
+  // The derivatives pass registers an execution model limitation on the
+  // function, which the late checks verify when they reach OpFunction.
+  CompileSuccessfully(DerivativeShader("Vertex"));
+  EXPECT_EQ(SPV_ERROR_INVALID_ID, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("Derivative instructions require Fragment or GLCompute "
+                        "execution model: DPdx"));
+
+  CompileSuccessfully(DerivativeShader("Fragment"));
+  EXPECT_EQ(SPV_SUCCESS, ValidateInstructions());
+}
+
+TEST_F(ValidateMultiPassOpcodes, DerivativeOperandsCheckedByDerivativesPass) {
+  // OpDPdx is also checked by the derivatives pass itself.
+  std::string spirv = DerivativeShader("Fragment");
+  const std::string dx = "%dx = OpDPdx %f32 %x";
+  spirv.replace(spirv.find(dx), dx.size(), "%dx = OpDPdx %u32 %x");
+  CompileSuccessfully(spirv);
+  EXPECT_EQ(SPV_ERROR_INVALID_DATA, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("Expected Result Type to be float scalar or vector "
+                        "type: DPdx"));
+}
+
+TEST_F(ValidateMultiPassOpcodes, FunctionCheckedByFunctionPass) {
+  // OpFunction is checked by the function pass and by the late checks.
+  const std::string spirv = R"(
+OpCapability Shader
+OpCapability Linkage
+OpMemoryModel Logical GLSL450
+%void = OpTypeVoid
+%f32 = OpTypeFloat 32
+%func = OpTypeFunction %void
+%main = OpFunction %f32 None %func
+%entry = OpLabel
+OpUnreachable
+OpFunctionEnd
+)";
+  CompileSuccessfully(spirv);
+  EXPECT_EQ(SPV_ERROR_INVALID_ID, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("does not match the Function Type's return type"));
+}
+
+TEST_F(ValidateMultiPassOpcodes, ForwardPointerCheckedByTypePass) {
+  // OpTypeForwardPointer does not generate a type, but is still dispatched
+  // to the type pass.
+  const std::string spirv = R"(
+OpCapability GenericPointer
+OpCapability VariablePointersStorageBuffer
+OpMemoryModel Logical GLSL450
+OpEntryPoint Fragment %1 "main"
+OpExecutionMode %1 OriginLowerLeft
+OpTypeForwardPointer %2 CrossWorkgroup
+%int = OpTypeInt 32 1
+%2 = OpTypePointer Function %int
+%void = OpTypeVoid
+%3 = OpTypeFunction %void
+%1 = OpFunction %void None %3
+%4 = OpLabel
+OpReturn
+OpFunctionEnd
+)";
+  CompileSuccessfully(spirv, SPV_ENV_UNIVERSAL_1_3);
+  EXPECT_EQ(SPV_ERROR_INVALID_ID, ValidateInstructions(SPV_ENV_UNIVERSAL_1_3));
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("Storage class in OpTypeForwardPointer does not match "
+                        "the pointer definition."));
+}
+
+TEST_F(ValidateMultiPassOpcodes, CompositeExtractCheckedByCompositesPass) {
+  // OpCompositeExtract is checked by the composites pass as well as by the
+  // passes that see every instruction.
+  const std::string spirv = R"(
+OpCapability Shader
+OpCapability Linkage
+OpMemoryModel Logical GLSL450
+%void = OpTypeVoid
+%func = OpTypeFunction %void
+%f32 = OpTypeFloat 32
+%v2f32 = OpTypeVector %f32 2
+%f32_0 = OpConstant %f32 0
+%vec = OpConstantComposite %v2f32 %f32_0 %f32_0
+%main = OpFunction %void None %func
+%entry = OpLabel
+%x = OpCompositeExtract %f32 %vec 2
+OpReturn
+OpFunctionEnd
+)";
+  CompileSuccessfully(spirv);
+  EXPECT_EQ(SPV_ERROR_INVALID_DATA, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("Vector access is out of bounds"));
+}
+
+}  // namespace
+}  // namespace val
+}  // namespace spvtools
@@ -25,7 +25,9 @@ namespace spvtools {
 namespace val {
 namespace {
 
+using ::testing::ElementsAre;
 using ::testing::HasSubstr;
+using ::testing::IsEmpty;
 
 using ValidationStateTest = spvtest::ValidateBase<bool>;
 
@@ -232,6 +234,45 @@ TEST_F(ValidationStateTest, CheckAccessChainIndexesLimitOption) {
   EXPECT_EQ(100u, options_->universal_limits_.max_access_chain_indexes);
 }
 
+const char kSemanticallyInvalidBody[] =
+    " %void   = OpTypeVoid"
+    " %void_f = OpTypeFunction %void"
+    " %float  = OpTypeFloat 32"
+    " %one    = OpConstant %float 1"
+    " %func   = OpFunction %void None %void_f"
+    " %label  = OpLabel"
+    " %sum    = OpIAdd %float %one %one"
+    "           OpReturn"
+    "           OpFunctionEnd ";
+
+const char kBlockBeforeDominatorBody[] =
+    " %void   = OpTypeVoid"
+    " %void_f = OpTypeFunction %void"
+    " %func   = OpFunction %void None %void_f"
+    " %entry  = OpLabel"
+    "           OpBranch %b"
+    " %c      = OpLabel"
+    "           OpReturn"
+    " %b      = OpLabel"
+    "           OpBranch %c"
+    "           OpFunctionEnd ";
+
+TEST_F(ValidationStateTest, StructuralOnlySkipsInstructionSemantics) {
+  CompileSuccessfully(std::string(kHeader) + kSemanticallyInvalidBody);
+  EXPECT_EQ(SPV_ERROR_INVALID_DATA, ValidateAndRetrieveValidationState());
+
+  spvValidatorOptionsSetStructuralOnly(options_, true);
+  EXPECT_EQ(SPV_SUCCESS, ValidateAndRetrieveValidationState());
+}
+
+TEST_F(ValidationStateTest, StructuralOnlyChecksControlFlow) {
+  spvValidatorOptionsSetStructuralOnly(options_, true);
+  CompileSuccessfully(std::string(kHeader) + kBlockBeforeDominatorBody);
+  EXPECT_EQ(SPV_ERROR_INVALID_CFG, ValidateAndRetrieveValidationState());
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("appears in the binary before its dominator"));
+}
+
 TEST_F(ValidationStateTest, CheckNonRecursiveBodyGood) {
   std::string spirv = std::string(kHeader) + kNonRecursiveBody;
   CompileSuccessfully(spirv);
@@ -282,6 +323,62 @@ TEST_F(ValidationStateTest, CheckVulkanIndirectlyRecursiveBodyBad) {
                         " %1 = OpFunction %void Pure|Const %3\n"));
 }
 
+TEST_F(ValidationStateTest, EntryPointReferences) {
+  // The helper function %12 is called by both entry points. Ids are numbered
+  // in order of first appearance.
+  const std::string spirv = R"(
+               OpCapability Shader
+               OpMemoryModel Logical GLSL450
+               OpEntryPoint GLCompute %1 "main1"
+               OpEntryPoint GLCompute %2 "main2"
+               OpExecutionMode %1 LocalSize 1 1 1
+               OpExecutionMode %2 LocalSize 1 1 1
+          %3 = OpTypeVoid
+          %4 = OpTypeFunction %3
+          %5 = OpTypeFloat 32
+          %6 = OpTypeStruct %5
+          %7 = OpTypePointer Private %6
+          %8 = OpTypePointer Private %5
+          %9 = OpVariable %7 Private
+         %10 = OpVariable %8 Private
+         %11 = OpVariable %8 Private
+         %12 = OpFunction %3 None %4
+         %13 = OpLabel
+         %14 = OpLoad %5 %10
+               OpReturn
+               OpFunctionEnd
+          %1 = OpFunction %3 None %4
+         %15 = OpLabel
+         %16 = OpFunctionCall %3 %12
+         %17 = OpLoad %6 %9
+               OpReturn
+               OpFunctionEnd
+          %2 = OpFunction %3 None %4
+         %18 = OpLabel
+         %19 = OpFunctionCall %3 %12
+               OpReturn
+               OpFunctionEnd
+)";
+  CompileSuccessfully(spirv);
+  ASSERT_EQ(SPV_SUCCESS, ValidateAndRetrieveValidationState());
+
+  // Global ids, reached directly or through other globals.
+  EXPECT_THAT(vstate_->EntryPointReferences(9), ElementsAre(1u));
+  EXPECT_THAT(vstate_->EntryPointReferences(7), ElementsAre(1u));
+  EXPECT_THAT(vstate_->EntryPointReferences(6), ElementsAre(1u));
+  EXPECT_THAT(vstate_->EntryPointReferences(10), ElementsAre(1u, 2u));
+  EXPECT_THAT(vstate_->EntryPointReferences(5), ElementsAre(1u, 2u));
+  EXPECT_THAT(vstate_->EntryPointReferences(11), IsEmpty());
+
+  // Functions and the ids defined in them.
+  EXPECT_THAT(vstate_->EntryPointReferences(12), ElementsAre(1u, 2u));
+  EXPECT_THAT(vstate_->EntryPointReferences(14), ElementsAre(1u, 2u));
+  EXPECT_THAT(vstate_->EntryPointReferences(17), ElementsAre(1u));
+
+  // Unknown ids.
+  EXPECT_THAT(vstate_->EntryPointReferences(100), IsEmpty());
+}
+
 }  // namespace
 }  // namespace val
 }  // namespace spvtools
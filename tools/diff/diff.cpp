@@ -91,8 +91,8 @@ std::unique_ptr<spvtools::opt::IRContext> load_module(const char* path) {
             SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS);
   }
 
-  std::vector<uint32_t> contents;
-  if (!ReadBinaryFile<uint32_t>(path, &contents)) return {};
+  InputFileContents<uint32_t> contents;
+  if (!MapBinaryFile<uint32_t>(path, &contents)) return {};
 
   return spvtools::BuildModule(kDefaultEnvironment,
                                spvtools::utils::CLIMessageConsumer,
@@ -18,8 +18,17 @@
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
+#include <utility>
 #include <vector>
 
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SPIRV_TOOLS_IO_HAS_MMAP 1
+#endif
+
 #if defined(SPIRV_WINDOWS)
 #include <fcntl.h>
 #include <io.h>
@@ -121,6 +130,119 @@ bool ReadTextFile(const char* filename, std::vector<T>* data) {
   return succeeded;
 }
 
+// The read-only contents of an input file, viewed as an array of elements of
+// type |T|. Regular files are memory mapped where the platform allows it, so
+// large modules are consumed in place instead of being copied into a growing
+// vector. Other inputs (standard input, pipes, empty files) are read into an
+// owned buffer with ReadBinaryFile.
+template <typename T>
+class InputFileContents {
+ public:
+  InputFileContents() = default;
+  InputFileContents(const InputFileContents&) = delete;
+  InputFileContents& operator=(const InputFileContents&) = delete;
+
+  // Moving transfers the mapping or the buffer and leaves |other| empty.
+  InputFileContents(InputFileContents&& other)
+      : mapping_(other.mapping_),
+        mapping_size_(other.mapping_size_),
+        buffer_(std::move(other.buffer_)) {
+    other.mapping_ = nullptr;
+    other.mapping_size_ = 0;
+    other.buffer_.clear();
+  }
+  InputFileContents& operator=(InputFileContents&& other) {
+    if (this != &other) {
+      Unmap();
+      mapping_ = other.mapping_;
+      mapping_size_ = other.mapping_size_;
+      buffer_ = std::move(other.buffer_);
+      other.mapping_ = nullptr;
+      other.mapping_size_ = 0;
+      other.buffer_.clear();
+    }
+    return *this;
+  }
+
+  ~InputFileContents() { Unmap(); }
+
+  const T* data() const {
+    return mapping_ ? static_cast<const T*>(mapping_) : buffer_.data();
+  }
+  size_t size() const {
+    return mapping_ ? mapping_size_ / sizeof(T) : buffer_.size();
+  }
+
+  // Returns a copy of the contents as a vector.
+  std::vector<T> ToVector() const {
+    return std::vector<T>(data(), data() + size());
+  }
+
+ private:
+  template <typename U>
+  friend bool MapBinaryFile(const char* filename,
+                            InputFileContents<U>* contents);
+
+  // Releases the mapping, if any.
+  void Unmap() {
+#if defined(SPIRV_TOOLS_IO_HAS_MMAP)
+    if (mapping_ != nullptr) munmap(mapping_, mapping_size_);
+#endif
+    mapping_ = nullptr;
+    mapping_size_ = 0;
+  }
+
+  void* mapping_ = nullptr;
+  size_t mapping_size_ = 0;
+  std::vector<T> buffer_;
+};
+
+// Makes the contents of the file named |filename| available through
+// |contents|, assuming each element in the file is of type |T|. Regular files
+// are memory mapped; if |filename| is nullptr or "-", or the file cannot be
+// mapped, falls back to ReadBinaryFile. If any error occurs, writes error
+// messages to standard error and returns false.
+template <typename T>
+bool MapBinaryFile(const char* filename, InputFileContents<T>* contents) {
+  *contents = InputFileContents<T>();
+#if defined(SPIRV_TOOLS_IO_HAS_MMAP)
+  const bool use_file = filename && strcmp("-", filename);
+  if (use_file) {
+    const int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+      fprintf(stderr, "error: file does not exist '%s'\n", filename);
+      return false;
+    }
+    struct stat st;
+    void* mapping = MAP_FAILED;
+    size_t size = 0;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+      size = static_cast<size_t>(st.st_size);
+      if (sizeof(T) != 1 && (size % sizeof(T))) {
+        close(fd);
+        fprintf(
+            stderr,
+            "error: file size should be a multiple of %zd; file '%s' corrupt\n",
+            sizeof(T), filename);
+        return false;
+      }
+      mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    // The mapping stays valid after the descriptor is closed.
+    close(fd);
+    if (mapping != MAP_FAILED) {
+#if defined(MADV_SEQUENTIAL)
+      madvise(mapping, size, MADV_SEQUENTIAL);
+#endif
+      contents->mapping_ = mapping;
+      contents->mapping_size_ = size;
+      return true;
+    }
+  }
+#endif
+  return ReadBinaryFile<T>(filename, &contents->buffer_);
+}
+
 namespace {
 // A class to create and manage a file for outputting data.
 class OutputFile {
@@ -863,17 +863,21 @@ int main(int argc, const char** argv) {
     return 1;
   }
 
-  std::vector<uint32_t> binary;
-  if (!ReadBinaryFile<uint32_t>(in_file, &binary)) {
+  InputFileContents<uint32_t> input;
+  if (!MapBinaryFile<uint32_t>(in_file, &input)) {
     return 1;
   }
 
-  // By using the same vector as input and output, we save time in the case
-  // that there was no change.
+  // The input is read in place from the mapped file, so the only full copy
+  // of the module is the optimized output.
+  std::vector<uint32_t> binary;
   bool ok =
-      optimizer.Run(binary.data(), binary.size(), &binary, optimizer_options);
+      optimizer.Run(input.data(), input.size(), &binary, optimizer_options);
 
-  if (!WriteFile<uint32_t>(out_file, "wb", binary.data(), binary.size())) {
+  // If optimization fails, the input is written out unchanged.
+  const uint32_t* output = ok ? binary.data() : input.data();
+  const size_t output_size = ok ? binary.size() : input.size();
+  if (!WriteFile<uint32_t>(out_file, "wb", output, output_size)) {
     return 1;
   }
 
@@ -68,6 +68,29 @@ Options:
                                    be allowed by the target environment.
   --before-hlsl-legalization       Allows code patterns that are intended to be
                                    fixed by spirv-opt's legalization passes.
+  --structural-only                Only check the module's structure: layout, ids,
+                                   types, functions and control flow. Skips the
+                                   semantic checks of instructions, decorations,
+                                   built-ins and interfaces.
+  --num-threads                    <number of threads used for per-function checks>
+                                   0 uses one thread per hardware thread. Defaults to 1.
+  --cache-dir                      <directory>
+                                   Reuse the outcome of validating the same module with
+                                   the same options from the given existing directory,
+                                   and store new outcomes there. Outcomes found in the
+                                   directory are trusted, so only use a directory that
+                                   untrusted users cannot write to.
+  --cache-salt                     <string>
+                                   Only reuse cached outcomes stored with the same
+                                   string. Use a string that identifies the build of
+                                   the tools, such as a hash of the executable.
+                                   Development builds only use the cache when a salt
+                                   is given.
+  --time-report                    Print the time (validating thread CPU time and wall
+                                   time) used by each validation stage, and the
+                                   number of instructions it processed, to standard
+                                   error output. Currently it supports only Unix
+                                   systems.
   --version                        Display validator version information.
   --target-env                     {%s}
                                    Use validation rules from the specified environment.
@@ -162,6 +185,40 @@ int main(int argc, char** argv) {
         options.SetAllowLocalSizeId(true);
       } else if (0 == strcmp(cur_arg, "--relax-struct-store")) {
         options.SetRelaxStructStore(true);
+      } else if (0 == strcmp(cur_arg, "--structural-only")) {
+        options.SetStructuralOnly(true);
+      } else if (0 == strcmp(cur_arg, "--num-threads")) {
+        uint32_t num_threads = 0;
+        if (argi + 1 < argc && sscanf(argv[++argi], "%u", &num_threads) == 1) {
+          options.SetNumThreads(num_threads);
+        } else {
+          fprintf(stderr, "error: missing argument to %s\n", cur_arg);
+          continue_processing = false;
+          return_code = 1;
+        }
+      } else if (0 == strcmp(cur_arg, "--time-report")) {
+        if (!options.SetTimeReport(&std::cerr)) {
+          fprintf(stderr, "error: %s is not supported by this build\n",
+                  cur_arg);
+          continue_processing = false;
+          return_code = 1;
+        }
+      } else if (0 == strcmp(cur_arg, "--cache-dir")) {
+        if (argi + 1 < argc) {
+          options.SetCacheDirectory(argv[++argi]);
+        } else {
+          fprintf(stderr, "error: missing argument to %s\n", cur_arg);
+          continue_processing = false;
+          return_code = 1;
+        }
+      } else if (0 == strcmp(cur_arg, "--cache-salt")) {
+        if (argi + 1 < argc) {
+          options.SetCacheSalt(argv[++argi]);
+        } else {
+          fprintf(stderr, "error: missing argument to %s\n", cur_arg);
+          continue_processing = false;
+          return_code = 1;
+        }
       } else if (0 == cur_arg[1]) {
         // Setting a filename of "-" to indicate stdin.
         if (!inFile) {
@@ -192,8 +249,8 @@ int main(int argc, char** argv) {
     return return_code;
   }
 
-  std::vector<uint32_t> contents;
-  if (!ReadBinaryFile<uint32_t>(inFile, &contents)) return 1;
+  InputFileContents<uint32_t> contents;
+  if (!MapBinaryFile<uint32_t>(inFile, &contents)) return 1;
 
   spvtools::SpirvTools tools(target_env);
   tools.SetMessageConsumer(spvtools::utils::CLIMessageConsumer);
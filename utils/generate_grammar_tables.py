@@ -156,6 +156,25 @@ def generate_extension_arrays(extensions):
     return '\n'.join(arrays)
 
 
+def generate_name_index(array_name, names):
+    """Returns the C definition of an index into a table, sorted by name.
+
+    Element i of the generated uint16_t array is the position in the table of
+    the entry with the i-th smallest name, so that names can be looked up by
+    binary search.  Entries sharing a name stay in table order.
+
+    Arguments:
+      - array_name: the name of the generated array.
+      - names: the names of the table entries, in table order.
+    """
+    assert len(names) < 2**16
+    index = sorted(range(len(names)), key=lambda i: names[i])
+    rows = [', '.join(str(i) for i in index[start:start + 16])
+            for start in range(0, len(index), 16)]
+    return 'static const uint16_t {}[] = {{\n  {}\n}};'.format(
+        array_name, ',\n  '.join(rows))
+
+
 def convert_operand_kind(operand_tuple):
     """Returns the corresponding operand type used in spirv-tools for the given
     operand kind and quantifier used in the JSON grammar.
@@ -371,8 +390,11 @@ def generate_instruction_table(inst_table):
     insts = [generate_instruction(inst, False) for inst in inst_table]
     insts = ['static const spv_opcode_desc_t kOpcodeTableEntries[] = {{\n'
              '  {}\n}};'.format(',\n  '.join(insts))]
+    name_index = generate_name_index(
+        'kOpcodeTableNameIndex', [inst['opname'] for inst in inst_table])
 
-    return '{}\n\n{}\n\n{}'.format(caps_arrays, exts_arrays, '\n'.join(insts))
+    return '{}\n\n{}\n\n{}\n\n{}'.format(caps_arrays, exts_arrays,
+                                         '\n'.join(insts), name_index)
 
 
 def generate_extended_instruction_table(json_grammar, set_name, operand_kind_prefix=""):
@@ -397,8 +419,11 @@ def generate_extended_instruction_table(json_grammar, set_name, operand_kind_pre
     insts = [generate_instruction(inst, True) for inst in inst_table]
     insts = ['static const spv_ext_inst_desc_t {}_entries[] = {{\n'
              '  {}\n}};'.format(set_name, ',\n  '.join(insts))]
+    name_index = generate_name_index(
+        '{}_name_index'.format(set_name),
+        [inst['opname'] for inst in inst_table])
 
-    return '{}\n\n{}'.format(caps_arrays, '\n'.join(insts))
+    return '{}\n\n{}\n\n{}'.format(caps_arrays, '\n'.join(insts), name_index)
 
 
 class EnumerantInitializer(object):
@@ -510,16 +535,20 @@ def generate_enum_operand_kind(enum, synthetic_exts_list):
     synthetic_exts_list.extend(extension_map.values())
 
     name = '{}_{}Entries'.format(PYGEN_VARIABLE_PREFIX, kind)
+    index_name = '{}_{}NameIndex'.format(PYGEN_VARIABLE_PREFIX, kind)
+    name_index = generate_name_index(
+        index_name, [e.get('enumerant') for e in entries])
     entries = ['  {}'.format(generate_enum_operand_kind_entry(e, extension_map))
                for e in entries]
 
     template = ['static const spv_operand_desc_t {name}[] = {{',
-                '{entries}', '}};']
+                '{entries}', '}};', '', '{name_index}']
     entries = '\n'.join(template).format(
         name=name,
-        entries=',\n'.join(entries))
+        entries=',\n'.join(entries),
+        name_index=name_index)
 
-    return kind, name, entries
+    return kind, name, index_name, entries
 
 
 def generate_operand_kind_table(enums):
@@ -544,15 +573,15 @@ def generate_operand_kind_table(enums):
     optional_enums = [e for e in enums if e[0] in optional_enums]
     enums.extend(optional_enums)
 
-    enum_kinds, enum_names, enum_entries = zip(*enums)
+    enum_kinds, enum_names, enum_index_names, enum_entries = zip(*enums)
     # Mark the last few as optional ones.
     enum_quantifiers = [''] * (len(enums) - len(optional_enums)) + ['?'] * len(optional_enums)
     # And we don't want redefinition of them.
     enum_entries = enum_entries[:-len(optional_enums)]
     enum_kinds = [convert_operand_kind(e)
                   for e in zip(enum_kinds, enum_quantifiers)]
-    table_entries = zip(enum_kinds, enum_names, enum_names)
-    table_entries = ['  {{{}, ARRAY_SIZE({}), {}}}'.format(*e)
+    table_entries = zip(enum_kinds, enum_names, enum_names, enum_index_names)
+    table_entries = ['  {{{}, ARRAY_SIZE({}), {}, {}}}'.format(*e)
                      for e in table_entries]
 
     template = [